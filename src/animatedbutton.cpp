@@ -1,14 +1,15 @@
 
 #include "animatedbutton.h"
 
-AnimatedButton::AnimatedButton (const std::string& black_icon,
+AnimatedButton::AnimatedButton (IconAtlas& icons,
+                                const std::string& black_icon,
                                 const std::string& white_icon,
                                 int size,
                                 sigc::slot<void> callback,
                                 const std::vector<std::string>& css_classes):
     button (),
-    pixbuf_black (Gdk::Pixbuf::create_from_file (black_icon, -1, size, true)),
-    pixbuf_white (Gdk::Pixbuf::create_from_file (white_icon, -1, size, true)),
+    pixbuf_black (icons.get (black_icon, -1, size)),
+    pixbuf_white (icons.get (white_icon, -1, size)),
     image (pixbuf_black)
 {
     // Remove the border of the button
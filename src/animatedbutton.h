@@ -28,6 +28,8 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #include <string>
 #include <vector>
 
+#include "iconatlas.h"
+
 class AnimatedButton {
 
     private:
@@ -39,7 +41,8 @@ class AnimatedButton {
 
     public:
 
-        AnimatedButton (const std::string& black_icon,
+        AnimatedButton (IconAtlas& icons,
+                        const std::string& black_icon,
                         const std::string& white_icon,
                         int size,
                         sigc::slot<void> callback,
@@ -0,0 +1,49 @@
+/*
+bodysink.h - Interface of the destinations of the responses bodies.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BODYSINK_H
+#define BODYSINK_H
+
+#include <cstddef>
+
+/* A BodySink receives the body of a response while it is transferred. The
+   methods are called from the transfers thread. */
+class BodySink {
+
+    public:
+
+        virtual ~BodySink () {}
+
+        /* The length of the body is announced (by the Content-Length header).
+           It is only a hint: the body may be shorter or longer. */
+        virtual void set_length (size_t length) {}
+
+        // Write some bytes of the body. Return false if an error ocurred, to
+        // abort the transfer.
+        virtual bool write (const char* bytes, size_t length) = 0;
+
+        // The body has been completely received.
+        virtual void close () {}
+
+};
+
+#endif
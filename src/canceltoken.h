@@ -0,0 +1,51 @@
+/*
+canceltoken.h - Token to cancel requests.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CANCELTOKEN_H
+#define CANCELTOKEN_H
+
+#include <atomic>
+
+/* A token shared between a view and the requests it made. Cancelling it
+   aborts the transfers and suppresses the results of the requests, unless
+   an identical request made with another token still waits for them. */
+class CancelToken {
+
+    private:
+
+        // True once cancelled
+        std::atomic<bool> cancelled;
+
+    public:
+
+        CancelToken ();
+        ~CancelToken ();
+
+        // Cancel the requests made with this token.
+        inline void cancel () { cancelled = true; }
+
+        // Return true if the requests were cancelled.
+        inline bool is_cancelled () const { return cancelled; }
+
+};
+
+#endif
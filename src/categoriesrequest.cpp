@@ -0,0 +1,87 @@
+/*
+categoriesrequest.cpp - Request the list of categories.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <rapidjson/document.h>
+
+#include "categoriesrequest.h"
+#include "categoriesresult.h"
+
+CategoriesRequest::CategoriesRequest (
+    const std::string& server_address, CategoriesListener& listener):
+        Request (server_address), listener(listener)
+{}
+
+CategoriesRequest::~CategoriesRequest ()
+{}
+
+std::string CategoriesRequest::get_api_function () const
+{
+    return "getcategories";
+}
+
+void CategoriesRequest::run ()
+{
+    auto r = std::make_unique<CategoriesResult>();
+    rapidjson::Document d;
+
+    // Don't parse results that nobody will see
+    auto followers = land ();
+    if (is_cancelled () and followers.empty ()) {
+        return;
+    }
+
+    try {
+        get_json_response (d);
+        if (not d.HasMember ("categories") or not d["categories"].IsArray ()) {
+            std::cerr << "getcategories request: no 'categories' list in json"
+                << std::endl;
+            r->set_error (true);
+        } else {
+            const rapidjson::Value& categories_array = d["categories"];
+            for (rapidjson::SizeType i = 0; i < categories_array.Size ();
+                 i++)
+            {
+                auto& c = categories_array[i];
+                if (not c.IsString ()) {
+                    throw std::runtime_error (
+                        "getcategories request: invalid category in json");
+                }
+                r->add (std::string (c.GetString (), c.GetStringLength ()));
+            }
+            r->set_error (false);
+        }
+    } catch (std::runtime_error& e) {
+        std::cerr << e.what () << std::endl;
+        r->set_error (true);
+    }
+
+    // Pass a copy of the result to the identical requests
+    for (auto& f: followers) {
+        auto copy = std::make_unique<CategoriesResult> (*r);
+        static_cast<CategoriesRequest&>(*f).listener.categories_received (
+            copy);
+    }
+    if (not is_cancelled ()) {
+        listener.categories_received (r);
+    }
+}
@@ -0,0 +1,54 @@
+/*
+categoriesrequest.h - Request the list of categories.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CATEGORIESREQUEST_H
+#define CATEGORIESREQUEST_H
+
+#include <string>
+
+#include "categorieslistener.h"
+#include "request.h"
+
+class CategoriesRequest: public Request {
+
+    private:
+
+        // Listener to receive the event of categories received.
+        CategoriesListener& listener;
+
+    public:
+
+        CategoriesRequest (
+            const std::string& server_address, CategoriesListener& listener);
+        ~CategoriesRequest ();
+
+        // Run this request.
+        void run ();
+
+    protected:
+
+        // Return the API function to call.
+        std::string get_api_function () const;
+
+};
+
+#endif
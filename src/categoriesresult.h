@@ -0,0 +1,56 @@
+/*
+categoriesresult.h - The result from a categories request.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CATEGORIESRESULT_H
+#define CATEGORIESRESULT_H
+
+#include <string>
+#include <vector>
+
+#include "requestresult.h"
+
+class CategoriesResult: public RequestResult {
+
+    private:
+
+        // List of categories
+        std::vector<std::string> categories;
+
+    public:
+
+        CategoriesResult ();
+        ~CategoriesResult ();
+
+        // Add a category.
+        inline void add (std::string&& category)
+            { categories.push_back (std::move (category)); }
+
+        // Return the list of categories.
+        inline std::vector<std::string>& get_categories ()
+            { return categories; }
+
+        // Return the number of categories.
+        inline int size () const { return categories.size (); }
+
+};
+
+#endif
@@ -435,26 +435,167 @@ core_download_media (Media *m, char **errstr)
 
 */
 
+#include "categoriesrequest.h"
 #include "core.h"
+#include "mediasrequest.h"
+#include "paths.h"
+#include "posterrequest.h"
+#include "profilepicturerequest.h"
+#include "profilepicturesrequest.h"
 #include "profilesrequest.h"
-
-Core::Core (const std::string& server_address):
-    server_address (server_address), request_manager ()
+#include "searchrequest.h"
+
+Core::Core (const std::string& server_address,
+            unsigned int num_workers,
+            bool http2):
+    server_address (server_address), profile (),
+    image_cache (Paths::get_cache (), IMAGE_CACHE_SIZE),
+    pixbuf_cache (PIXBUF_CACHE_SIZE), batch_pictures (true), flights (),
+    request_manager (num_workers, http2)
 {}
 
 Core::~Core ()
 {}
 
-void Core::request_profiles (ProfilesListener& listener)
+void Core::add (std::unique_ptr<Request>& request,
+               const std::shared_ptr<CancelToken>& token,
+               const std::shared_ptr<RequestPriority>& priority)
+{
+    request->set_token (token);
+    request->set_priority (priority);
+    if (not flights.join (request)) {
+        request_manager.add (request);
+    }
+}
+
+void Core::request_profiles (ProfilesListener& listener,
+                             const std::string& etag,
+                             const std::string& last_modified)
 {
     std::unique_ptr<Request> request = std::make_unique<ProfilesRequest> (
+        server_address, listener, etag, last_modified);
+    add (request);
+}
+
+void Core::request_profile_picture (const std::string& profile,
+                                    int size,
+                                    ProfilePictureListener& listener,
+                                    const std::shared_ptr<CancelToken>& token)
+{
+    auto pixbuf = pixbuf_cache.lookup (
+        ProfilePictureRequest::get_source (profile), size, size);
+    if (pixbuf) {
+        auto result = std::make_unique<PictureResult> (profile);
+        result->set_pixbuf (pixbuf);
+        listener.profile_picture_received (result);
+        return;
+    }
+    std::unique_ptr<Request> request = std::make_unique<ProfilePictureRequest> (
+        server_address, profile, size, image_cache, pixbuf_cache, listener);
+    add (request, token);
+}
+
+void Core::request_profile_pictures (
+    const std::vector<std::string>& profiles,
+    int size,
+    ProfilePictureListener& listener,
+    const std::shared_ptr<CancelToken>& token)
+{
+    std::vector<std::string> missing;
+    for (auto& p: profiles) {
+        auto pixbuf = pixbuf_cache.lookup (
+            ProfilePictureRequest::get_source (p), size, size);
+        if (pixbuf) {
+            auto result = std::make_unique<PictureResult> (p);
+            result->set_pixbuf (pixbuf);
+            listener.profile_picture_received (result);
+        } else {
+            missing.push_back (p);
+        }
+    }
+
+    /* The pictures cached on disk are revalidated one by one, the batch
+       would download them again */
+    std::vector<std::string> batch;
+    for (auto& p: missing) {
+        ImageCache::Entry entry;
+        if (batch_pictures and not image_cache.lookup (
+                PictureRequest::get_cache_key (
+                    server_address, ProfilePictureRequest::get_source (p)),
+                entry))
+        {
+            batch.push_back (p);
+        } else {
+            request_profile_picture (p, size, listener, token);
+        }
+    }
+    if (batch.size () < 2) {
+        for (auto& p: batch) {
+            request_profile_picture (p, size, listener, token);
+        }
+        return;
+    }
+
+    // The pictures not received in the batch are requested one by one
+    auto fallback = [this, size, &listener, token] (
+        const std::vector<std::string>& profiles, bool supported) {
+        if (not supported) {
+            batch_pictures = false;
+        }
+        for (auto& p: profiles) {
+            request_profile_picture (p, size, listener, token);
+        }
+    };
+    std::unique_ptr<Request> request =
+        std::make_unique<ProfilePicturesRequest> (
+            server_address, batch, size, image_cache, pixbuf_cache, listener,
+            fallback);
+    add (request, token);
+}
+
+void Core::request_categories (CategoriesListener& listener)
+{
+    std::unique_ptr<Request> request = std::make_unique<CategoriesRequest> (
         server_address, listener);
-    request_manager.add (request);
+    add (request);
 }
 
-void Core::request_profile_picture (
-    const std::string& profile, ProfilePictureListener& listener)
+void Core::request_medias (const std::string& category,
+                           MediasListener& listener,
+                           const std::shared_ptr<CancelToken>& token)
 {
-    
+    std::unique_ptr<Request> request = std::make_unique<MediasRequest> (
+        server_address, profile, category, listener);
+    add (request, token);
+}
+
+void Core::search (const std::string& category,
+                   const std::string& text,
+                   SearchListener& listener,
+                   const std::shared_ptr<CancelToken>& token)
+{
+    std::unique_ptr<Request> request = std::make_unique<SearchRequest> (
+        server_address, category, text, listener);
+    add (request, token);
 }
 
+void Core::request_poster (const std::string& title_id,
+                           int width,
+                           int height,
+                           PosterListener& listener,
+                           const std::shared_ptr<CancelToken>& token,
+                           const std::shared_ptr<RequestPriority>& priority)
+{
+    auto pixbuf = pixbuf_cache.lookup (
+        PosterRequest::get_source (title_id), width, height);
+    if (pixbuf) {
+        auto result = std::make_unique<PictureResult> (title_id);
+        result->set_pixbuf (pixbuf);
+        listener.poster_received (result);
+        return;
+    }
+    std::unique_ptr<Request> request = std::make_unique<PosterRequest> (
+        server_address, title_id, width, height, image_cache, pixbuf_cache,
+        listener);
+    add (request, token, priority);
+}
@@ -63,33 +63,134 @@ int
 core_download_media (Media *m, char **errstr);
 */
 
+#include <atomic>
+#include <cstdint>
 #include <string>
-
+#include <vector>
+
+#include "canceltoken.h"
+#include "categorieslistener.h"
+#include "flights.h"
+#include "imagecache.h"
+#include "mediaslistener.h"
+#include "pixbufcache.h"
+#include "posterlistener.h"
 #include "profilepicturelistener.h"
 #include "profileslistener.h"
 #include "requestmanager.h"
+#include "requestpriority.h"
+#include "searchlistener.h"
 
 class Core {
 
     private:
 
+        // Maximum size of the pictures cache, in bytes
+        static const std::uintmax_t IMAGE_CACHE_SIZE = 64 * 1024 * 1024;
+
+        // Maximum size of the decoded pictures kept in memory, in bytes
+        static const size_t PIXBUF_CACHE_SIZE = 64 * 1024 * 1024;
+
         // Server address
         std::string server_address;
 
+        // Current profile
+        std::string profile;
+
+        // Cache of the downloaded pictures
+        ImageCache image_cache;
+
+        // Cache of the decoded pictures, shared by all the views
+        PixbufCache pixbuf_cache;
+
+        // False once the server fails to send several pictures at once
+        std::atomic<bool> batch_pictures;
+
+        // Identical requests in flight, to send them only once
+        Flights flights;
+
         // Object to collect the finished requests
         RequestManager request_manager;
 
     public:
 
-        Core (const std::string& server_address);
+        Core (const std::string& server_address,
+              unsigned int num_workers,
+              bool http2);
         ~Core ();
 
-        // Request the list of profiles.
-        void request_profiles (ProfilesListener& listener);
 
-        // Request a profile's picture.
+        // Return the requests manager (to query its counters).
+        inline const RequestManager& get_request_manager () const
+            { return request_manager; }
+
+        /* Request the list of profiles. If the validators of the list the
+           listener has are given, the result only tells that the list is
+           unchanged when the server says so. */
+        void request_profiles (ProfilesListener& listener,
+                               const std::string& etag = "",
+                               const std::string& last_modified = "");
+
+        /* Request a profile's picture, decoded to fit in a square of the
+           given size. If it is already decoded, the listener is called
+           right away. */
         void request_profile_picture (
-            const std::string& profile, ProfilePictureListener& listener);
+            const std::string& profile,
+            int size,
+            ProfilePictureListener& listener,
+            const std::shared_ptr<CancelToken>& token = nullptr);
+
+        /* Request the pictures of several profiles, in a single request if
+           the server supports it and one by one otherwise. The pictures
+           already decoded are passed right away, and the ones cached on
+           disk are revalidated one by one. */
+        void request_profile_pictures (
+            const std::vector<std::string>& profiles,
+            int size,
+            ProfilePictureListener& listener,
+            const std::shared_ptr<CancelToken>& token = nullptr);
+
+        // Set the current profile.
+        inline void set_profile (const std::string& profile)
+            { this->profile = profile; }
+
+        // Return the current profile.
+        inline const std::string& get_profile () const { return profile; }
+
+        // Request the list of categories.
+        void request_categories (CategoriesListener& listener);
+
+        // Request the list of medias of a category for the current profile.
+        void request_medias (
+            const std::string& category,
+            MediasListener& listener,
+            const std::shared_ptr<CancelToken>& token = nullptr);
+
+        // Search medias in a category by their title.
+        void search (const std::string& category,
+                     const std::string& text,
+                     SearchListener& listener,
+                     const std::shared_ptr<CancelToken>& token = nullptr);
+
+        /* Request the poster of a title, decoded at the given size. If it is
+           already decoded, the listener is called right away. The view can
+           change the priority while the poster waits for its transfer. */
+        void request_poster (
+            const std::string& title_id,
+            int width,
+            int height,
+            PosterListener& listener,
+            const std::shared_ptr<CancelToken>& token = nullptr,
+            const std::shared_ptr<RequestPriority>& priority = nullptr);
+
+    private:
+
+        /* Send a request, unless an identical one is in flight. In that case
+           the request gets the result of the other one. The token, if any,
+           cancels the request, and the priority, if any, ranks it. */
+        void add (std::unique_ptr<Request>& request,
+                  const std::shared_ptr<CancelToken>& token = nullptr,
+                  const std::shared_ptr<RequestPriority>& priority = nullptr);
 
 };
 
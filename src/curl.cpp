@@ -23,6 +23,39 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #include "curl.h"
 
 Curl::CurlGlobal Curl::curl_global;
+Curl::CurlPool Curl::curl_pool;
+
+Curl::CurlPool::CurlPool ():
+    share (nullptr)
+{
+    if (!(share = curl_share_init ())) {
+        throw std::runtime_error ("error in curl_share_init");
+    }
+    curl_share_setopt (share, CURLSHOPT_LOCKFUNC, &CurlPool::lock);
+    curl_share_setopt (share, CURLSHOPT_UNLOCKFUNC, &CurlPool::unlock);
+    curl_share_setopt (share, CURLSHOPT_USERDATA, this);
+    curl_share_setopt (share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt (share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    curl_share_setopt (share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+}
+
+Curl::CurlPool::~CurlPool ()
+{
+    // The handlers must be freed before the share
+    handlers.clear ();
+    curl_share_cleanup (share);
+}
+
+void Curl::CurlPool::lock (CURL* handle, curl_lock_data data,
+    curl_lock_access access, void* userptr)
+{
+    static_cast<CurlPool*>(userptr)->share_mutexes[data].lock ();
+}
+
+void Curl::CurlPool::unlock (CURL* handle, curl_lock_data data, void* userptr)
+{
+    static_cast<CurlPool*>(userptr)->share_mutexes[data].unlock ();
+}
 
 Curl::Curl ():
     handler (nullptr)
@@ -39,6 +72,49 @@ Curl::~Curl ()
     }
 }
 
+std::unique_ptr<Curl> Curl::acquire ()
+{
+    std::unique_ptr<Curl> curl;
+    {
+        std::lock_guard<std::mutex> lock(curl_pool.handlers_mutex);
+        if (curl_pool.handlers.size ()) {
+            curl = std::move (curl_pool.handlers.back ());
+            curl_pool.handlers.pop_back ();
+        }
+    }
+    if (not curl) {
+        // No idle handlers, create a new one attached to the share
+        curl = std::make_unique<Curl> ();
+        curl->setopt (CURLOPT_SHARE, curl_pool.share);
+    }
+    // The options are reset when the handler is released
+    if (not curl_pool.ca_file.empty ()) {
+        curl->setopt (CURLOPT_CAINFO, curl_pool.ca_file);
+    }
+    return curl;
+}
+
+void Curl::release (std::unique_ptr<Curl> curl)
+{
+    if (not curl) {
+        return;
+    }
+    // Reset the options, but keep the connections and the share
+    curl->reset ();
+    std::lock_guard<std::mutex> lock(curl_pool.handlers_mutex);
+    curl_pool.handlers.push_back (std::move (curl));
+}
+
+void Curl::set_ca_file (const std::string& ca_file)
+{
+    curl_pool.ca_file = ca_file;
+}
+
+void Curl::reset ()
+{
+    curl_easy_reset (handler);
+}
+
 void Curl::setopt (CURLoption option, const std::string& s)
 {
     CURLcode c;
@@ -67,6 +143,15 @@ void Curl::setopt (
     }
 }
 
+void Curl::setopt (CURLoption option, curl_xferinfo_callback func)
+{
+    CURLcode c;
+    if ((c = curl_easy_setopt (handler, option, func)) != CURLE_OK) {
+        throw std::runtime_error ("error in curl_easy_setop ("
+            + std::to_string(option) + "): " + curl_easy_strerror (c));
+    }
+}
+
 void Curl::setopt (CURLoption option, int i)
 {
     CURLcode c;
@@ -76,6 +161,33 @@ void Curl::setopt (CURLoption option, int i)
     }
 }
 
+void Curl::setopt (CURLoption option, long l)
+{
+    CURLcode c;
+    if ((c = curl_easy_setopt (handler, option, l)) != CURLE_OK) {
+        throw std::runtime_error ("error in curl_easy_setop ("
+            + std::to_string(option) + "): " + curl_easy_strerror (c));
+    }
+}
+
+long Curl::get_response_code ()
+{
+    long response_code = 0;
+    curl_easy_getinfo (handler, CURLINFO_RESPONSE_CODE, &response_code);
+    return response_code;
+}
+
+bool Curl::supports_http2 ()
+{
+    return curl_version_info (CURLVERSION_NOW)->features & CURL_VERSION_HTTP2;
+}
+
+void Curl::enable_http2 ()
+{
+    setopt (CURLOPT_HTTP_VERSION, static_cast<long> (CURL_HTTP_VERSION_2_0));
+    setopt (CURLOPT_PIPEWAIT, 1L);
+}
+
 void Curl::perform ()
 {
     CURLcode c;
@@ -85,3 +197,90 @@ void Curl::perform ()
     }
 }
 
+
+CurlMulti::CurlMulti ():
+    handler (nullptr)
+{
+    if (!(handler = curl_multi_init ())) {
+        throw std::runtime_error ("error in curl_multi_init");
+    }
+}
+
+CurlMulti::~CurlMulti ()
+{
+    if (handler) {
+        curl_multi_cleanup (handler);
+    }
+}
+
+void CurlMulti::setopt (CURLMoption option, long l)
+{
+    CURLMcode c;
+    if ((c = curl_multi_setopt (handler, option, l)) != CURLM_OK) {
+        throw std::runtime_error ("error in curl_multi_setopt ("
+            + std::to_string(option) + "): " + curl_multi_strerror (c));
+    }
+}
+
+void CurlMulti::add (Curl& curl)
+{
+    CURLMcode c;
+    if ((c = curl_multi_add_handle (handler, curl.handler)) != CURLM_OK) {
+        throw std::runtime_error (
+            std::string("error in curl_multi_add_handle: ")
+            + curl_multi_strerror (c));
+    }
+}
+
+void CurlMulti::remove (Curl& curl)
+{
+    CURLMcode c;
+    if ((c = curl_multi_remove_handle (handler, curl.handler)) != CURLM_OK) {
+        throw std::runtime_error (
+            std::string("error in curl_multi_remove_handle: ")
+            + curl_multi_strerror (c));
+    }
+}
+
+int CurlMulti::perform ()
+{
+    CURLMcode c;
+    int running;
+    if ((c = curl_multi_perform (handler, &running)) != CURLM_OK) {
+        throw std::runtime_error (std::string("error in curl_multi_perform: ")
+            + curl_multi_strerror (c));
+    }
+    return running;
+}
+
+void CurlMulti::poll (int timeout_ms)
+{
+    CURLMcode c;
+    if ((c = curl_multi_poll (handler, nullptr, 0, timeout_ms, nullptr))
+        != CURLM_OK)
+    {
+        throw std::runtime_error (std::string("error in curl_multi_poll: ")
+            + curl_multi_strerror (c));
+    }
+}
+
+void CurlMulti::wakeup ()
+{
+    curl_multi_wakeup (handler);
+}
+
+bool CurlMulti::next_done (void*& userp, CURLcode& code)
+{
+    CURLMsg* msg;
+    int queued;
+    while ((msg = curl_multi_info_read (handler, &queued))) {
+        if (msg->msg == CURLMSG_DONE) {
+            char* p = nullptr;
+            curl_easy_getinfo (msg->easy_handle, CURLINFO_PRIVATE, &p);
+            userp = p;
+            code = msg->data.result;
+            return true;
+        }
+    }
+    return false;
+}
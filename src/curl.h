@@ -24,14 +24,18 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #define CURL_H
 
 #include <curl/curl.h>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 class Curl {
 
     private:
 
         friend class CurlGlobal;
+        friend class CurlMulti;
 
         struct CurlGlobal {
 
@@ -51,6 +55,40 @@ class Curl {
         // Global initialization
         static CurlGlobal curl_global;
 
+        // Pool of reusable handlers. All of them share the DNS cache, the
+        // connections and the TLS sessions, so that a connection to the
+        // server is kept alive between requests.
+        struct CurlPool {
+
+            // Shared data between the handlers
+            CURLSH* share;
+
+            // Mutexes to protect each kind of shared data
+            std::mutex share_mutexes[CURL_LOCK_DATA_LAST];
+
+            // Idle handlers
+            std::vector<std::unique_ptr<Curl> > handlers;
+
+            // Mutex to protect the list of idle handlers
+            std::mutex handlers_mutex;
+
+            // File with the certificates to verify the server, empty to use
+            // the ones of the system
+            std::string ca_file;
+
+            CurlPool ();
+            ~CurlPool ();
+
+            // Callbacks to lock and unlock the shared data
+            static void lock (CURL* handle, curl_lock_data data,
+                curl_lock_access access, void* userptr);
+            static void unlock (
+                CURL* handle, curl_lock_data data, void* userptr);
+        };
+
+        // The pool of handlers
+        static CurlPool curl_pool;
+
         // CURL easy handler
         CURL* handler;
 
@@ -59,17 +97,83 @@ class Curl {
         Curl ();
         ~Curl ();
 
+        // Borrow a handler from the pool.
+        static std::unique_ptr<Curl> acquire ();
+
+        // Return a handler to the pool.
+        static void release (std::unique_ptr<Curl> curl);
+
+        /* Verify the server with the certificates of a file (for servers
+           with their own authority). Call it before the first transfer. */
+        static void set_ca_file (const std::string& ca_file);
+
+        // Wrapper to curl_easy_reset
+        void reset ();
+
         // Wrappers to curl_easy_setopt
         void setopt (CURLoption option, const std::string& s);
         void setopt (CURLoption option, void* ptr);
         void setopt (
             CURLoption option, size_t (*func)(void*, size_t, size_t, void*));
+        void setopt (CURLoption option, curl_xferinfo_callback func);
         void setopt (CURLoption option, int i);
+        void setopt (CURLoption option, long l);
+
+        // Return the HTTP response code of the last transfer.
+        long get_response_code ();
+
+        // Return true if the cURL library supports HTTP/2.
+        static bool supports_http2 ();
+
+        /* Ask for HTTP/2 in the next transfer, and wait for a connection
+           that can be multiplexed instead of opening a new one. If the
+           server doesn't speak HTTP/2, HTTP/1.1 is used. The transfers are
+           only multiplexed with TLS: in clear text HTTP/2 is reached with
+           an upgrade from HTTP/1.1, one transfer at a time. */
+        void enable_http2 ();
 
         // Wrapper to curl_easy_perform
         void perform ();
 
 };
 
+class CurlMulti {
+
+    private:
+
+        // CURL multi handler
+        CURLM* handler;
+
+    public:
+
+        CurlMulti ();
+        ~CurlMulti ();
+
+        // Wrapper to curl_multi_setopt
+        void setopt (CURLMoption option, long l);
+
+        // Wrapper to curl_multi_add_handle
+        void add (Curl& curl);
+
+        // Wrapper to curl_multi_remove_handle
+        void remove (Curl& curl);
+
+        // Wrapper to curl_multi_perform. Return the number of running
+        // transfers.
+        int perform ();
+
+        // Wrapper to curl_multi_poll
+        void poll (int timeout_ms);
+
+        // Wrapper to curl_multi_wakeup
+        void wakeup ();
+
+        /* Return the next finished transfer, in the pointer given with
+           CURLOPT_PRIVATE, and its result in code.
+           Return false if there are no more finished transfers. */
+        bool next_done (void*& userp, CURLcode& code);
+
+};
+
 #endif
 
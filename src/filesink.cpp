@@ -0,0 +1,59 @@
+/*
+filesink.cpp - Receive the body of a response in a file.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+
+#include "filesink.h"
+
+FileSink::FileSink (const std::filesystem::path& path):
+    path (path), file (nullptr), error (false)
+{}
+
+FileSink::~FileSink ()
+{
+    close ();
+}
+
+bool FileSink::write (const char* bytes, size_t length)
+{
+    if (not file and not error) {
+        if (!(file = fopen (path.c_str (), "wb"))) {
+            std::cerr << "cannot open file " << path << std::endl;
+            error = true;
+        }
+    }
+    if (not error and fwrite (bytes, 1, length, file) != length) {
+        error = true;
+    }
+    return not error;
+}
+
+void FileSink::close ()
+{
+    if (file) {
+        // Data still buffered may fail to be written here
+        if (fclose (file)) {
+            error = true;
+        }
+        file = nullptr;
+    }
+}
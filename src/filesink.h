@@ -0,0 +1,65 @@
+/*
+filesink.h - Receive the body of a response in a file.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FILESINK_H
+#define FILESINK_H
+
+#include <cstdio>
+#include <filesystem>
+
+#include "bodysink.h"
+
+class FileSink: public BodySink {
+
+    private:
+
+        // Path of the file
+        std::filesystem::path path;
+
+        // The opened file, or null if no bytes were written yet
+        FILE* file;
+
+        // True if some data could not be written
+        bool error;
+
+    public:
+
+        /* The file is created when the first bytes arrive, so that empty
+           responses don't touch the disk. */
+        FileSink (const std::filesystem::path& path);
+        ~FileSink ();
+
+        // Return the path of the file.
+        inline const std::filesystem::path& get_path () const { return path; }
+
+        // Return true if some data could not be written to the file.
+        inline bool get_error () const { return error; }
+
+        // Implementation of the BodySink interface.
+        bool write (const char* bytes, size_t length);
+
+        // Implementation of the BodySink interface.
+        void close ();
+
+};
+
+#endif
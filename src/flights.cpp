@@ -0,0 +1,89 @@
+/*
+flights.cpp - Coalesce identical requests in flight.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "flights.h"
+#include "request.h"
+
+Flights::Flights ():
+    flights (), mutex ()
+{}
+
+Flights::~Flights ()
+{}
+
+bool Flights::join (std::unique_ptr<Request>& request)
+{
+    auto key = request->get_key ();
+    std::lock_guard<std::mutex> lock (mutex);
+    auto it = flights.find (key);
+    if (it != flights.end () and is_waited (*it->second)) {
+        it->second->followers.push_back (std::move (request));
+        return true;
+    }
+    // The request in flight, if any, is being aborted; replace it
+    flights[key] = request.get ();
+    request->flights = this;
+    return false;
+}
+
+bool Flights::is_abandoned (Request& request)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    return not is_waited (request);
+}
+
+bool Flights::is_waited (Request& request)
+{
+    if (not request.is_cancelled ()) {
+        return true;
+    }
+    for (auto& f: request.followers) {
+        if (not f->is_cancelled ()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+RequestPriority::Class Flights::get_priority (Request& request)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    auto priority = request.get_priority ();
+    for (auto& f: request.followers) {
+        if (not f->is_cancelled () and f->get_priority () < priority) {
+            priority = f->get_priority ();
+        }
+    }
+    return priority;
+}
+
+std::vector<std::unique_ptr<Request> > Flights::land (Request& request)
+{
+    auto key = request.get_key ();
+    std::lock_guard<std::mutex> lock (mutex);
+    auto it = flights.find (key);
+    if (it != flights.end () and it->second == &request) {
+        flights.erase (it);
+    }
+    request.flights = nullptr;
+    return std::move (request.followers);
+}
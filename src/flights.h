@@ -0,0 +1,80 @@
+/*
+flights.h - Coalesce identical requests in flight.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FLIGHTS_H
+#define FLIGHTS_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "requestpriority.h"
+
+class Request;
+
+/* Keep the requests in flight by their key, so that an identical request
+   is attached to the one in flight instead of being sent again. When the
+   first one finishes, its result is passed to the listeners of all of
+   them. All the methods are thread safe. */
+class Flights {
+
+    private:
+
+        // Requests in flight, by their key
+        std::unordered_map<std::string, Request*> flights;
+
+        // Mutex to protect the requests in flight and their followers
+        std::mutex mutex;
+
+    public:
+
+        Flights ();
+        ~Flights ();
+
+        /* Attach a request to an identical one in flight, and return true.
+           If there is none, the request becomes the one in flight and it
+           must be sent; return false. */
+        bool join (std::unique_ptr<Request>& request);
+
+        /* Return true if a request in flight and the requests attached to
+           it were all cancelled. */
+        bool is_abandoned (Request& request);
+
+        /* Return the most urgent priority class of a request in flight and
+           the requests attached to it. */
+        RequestPriority::Class get_priority (Request& request);
+
+        /* The request in flight has its result. Return the requests attached
+           to it; identical requests joining later are sent again. */
+        std::vector<std::unique_ptr<Request> > land (Request& request);
+
+    private:
+
+        /* Return true if a request or the requests attached to it are not
+           cancelled. The mutex must be locked. */
+        static bool is_waited (Request& request);
+
+};
+
+#endif
@@ -0,0 +1,125 @@
+/*
+framescheduler.cpp - Scheduler of interface updates on the frames of a widget.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <glib.h>
+#include <glibmm/main.h>
+
+#include "framescheduler.h"
+
+FrameScheduler::FrameScheduler (Gtk::Widget& widget, long budget):
+    widget (widget), budget (budget), jobs (), ticking (false), tick_id (0),
+    idle_connection (), map_connection (), unmap_connection (), frames (0),
+    deferred (0), max_pending (0)
+{
+    map_connection = widget.signal_map ().connect (
+        sigc::mem_fun (*this, &FrameScheduler::on_map_changed));
+    unmap_connection = widget.signal_unmap ().connect (
+        sigc::mem_fun (*this, &FrameScheduler::on_map_changed));
+}
+
+FrameScheduler::~FrameScheduler ()
+{
+    remove_callback ();
+    map_connection.disconnect ();
+    unmap_connection.disconnect ();
+}
+
+void FrameScheduler::schedule (const std::function<void ()>& job)
+{
+    jobs.push_back (job);
+    install_callback ();
+}
+
+void FrameScheduler::install_callback ()
+{
+    if (ticking or idle_connection.connected ()) {
+        return;
+    }
+    if (widget.get_mapped ()) {
+        // The tick callback asks the frame clock for frames while installed
+        tick_id = widget.add_tick_callback (
+            sigc::mem_fun (*this, &FrameScheduler::on_tick));
+        ticking = true;
+    } else {
+        idle_connection = Glib::signal_idle ().connect (
+            sigc::mem_fun (*this, &FrameScheduler::on_idle));
+    }
+}
+
+void FrameScheduler::remove_callback ()
+{
+    if (ticking) {
+        widget.remove_tick_callback (tick_id);
+        ticking = false;
+    }
+    idle_connection.disconnect ();
+}
+
+void FrameScheduler::on_map_changed ()
+{
+    remove_callback ();
+    if (not jobs.empty ()) {
+        install_callback ();
+    }
+}
+
+bool FrameScheduler::on_tick (const Glib::RefPtr<Gdk::FrameClock>& clock)
+{
+    // Stop asking for frames when there is nothing else to do
+    ticking = run_jobs ();
+    return ticking;
+}
+
+bool FrameScheduler::on_idle ()
+{
+    // Returning false removes the callback
+    return run_jobs ();
+}
+
+bool FrameScheduler::run_jobs ()
+{
+    // The jobs scheduled by the jobs run in the next call
+    auto start = g_get_monotonic_time ();
+    auto n = jobs.size ();
+    while (n-- and g_get_monotonic_time () - start < budget) {
+        auto job = std::move (jobs.front ());
+        jobs.pop_front ();
+        job ();
+    }
+    frames++;
+
+    if (jobs.empty ()) {
+        return false;
+    }
+    deferred += jobs.size ();
+    if (jobs.size () > max_pending) {
+        max_pending = jobs.size ();
+    }
+    return true;
+}
+
+void FrameScheduler::print_stats (std::ostream& out) const
+{
+    out << "frames: " << frames << " with jobs, " << deferred
+        << " jobs deferred, at most " << max_pending << " pending, "
+        << jobs.size () << " pending" << std::endl;
+}
@@ -0,0 +1,128 @@
+/*
+framescheduler.h - Scheduler of interface updates on the frames of a widget.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <deque>
+#include <functional>
+#include <gdkmm/frameclock.h>
+#include <gtkmm/widget.h>
+#include <ostream>
+
+/* Run the changes of the interface in the update phase of the frames of a
+   widget, driven by its GdkFrameClock. Each frame runs jobs for a limited
+   time and leaves the rest for the next frames, so that applying a lot of
+   results doesn't make the frames late.
+
+   While the widget is not mapped (the window is iconified) it gets no
+   frames, so the jobs run when the main loop is idle instead, with the
+   same budget, and their results don't pile up.
+
+   It counts the jobs that had to wait for a later frame, to tune the
+   budget on slow hardware. It must be used from the main thread. */
+class FrameScheduler {
+
+    public:
+
+        // Default time of a frame to run jobs, in microseconds
+        static const long DEFAULT_FRAME_BUDGET = 4000;
+
+    private:
+
+        // Widget whose frames run the jobs
+        Gtk::Widget& widget;
+
+        // Time of a frame to run jobs, in microseconds
+        long budget;
+
+        // Jobs waiting for a frame
+        std::deque<std::function<void ()> > jobs;
+
+        // True while the tick callback is installed, and its identifier
+        bool ticking;
+        guint tick_id;
+
+        // Callback to run the jobs while the widget is not mapped
+        sigc::connection idle_connection;
+
+        // Connections to know when the widget is mapped and unmapped
+        sigc::connection map_connection;
+        sigc::connection unmap_connection;
+
+        // Number of frames (or idle calls, while not mapped) that ran jobs
+        size_t frames;
+
+        // Number of jobs that ran in a frame after the one they were
+        // scheduled for, once for each frame they waited
+        size_t deferred;
+
+        // Maximum number of jobs waiting at the end of a frame
+        size_t max_pending;
+
+    public:
+
+        FrameScheduler (Gtk::Widget& widget, long budget);
+        ~FrameScheduler ();
+
+        // Run a job in the next frames.
+        void schedule (const std::function<void ()>& job);
+
+        // Return the number of jobs waiting for a frame.
+        inline size_t get_pending () const { return jobs.size (); }
+
+        // Return the number of frames that ran jobs.
+        inline size_t get_frames () const { return frames; }
+
+        // Return the number of times a job was left for the next frame.
+        inline size_t get_deferred () const { return deferred; }
+
+        // Return the maximum number of jobs left for the next frame.
+        inline size_t get_max_pending () const { return max_pending; }
+
+        // Print the counters of the frames.
+        void print_stats (std::ostream& out) const;
+
+    private:
+
+        // Install the callback that runs the jobs, if none is installed
+        void install_callback ();
+
+        // Remove the callback that runs the jobs
+        void remove_callback ();
+
+        // The widget was mapped or unmapped, change the callback
+        void on_map_changed ();
+
+        // Callback of the frames
+        bool on_tick (const Glib::RefPtr<Gdk::FrameClock>& clock);
+
+        // Callback of the idle main loop
+        bool on_idle ();
+
+        /* Run the jobs until the budget is over. Return true if there are
+           jobs left. */
+        bool run_jobs ();
+
+};
+
+#endif
@@ -0,0 +1,143 @@
+/*
+iconatlas.cpp - Rendered icons, shared by all the widgets.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <glib.h>
+#include <iostream>
+#include <system_error>
+#include <vector>
+
+#include "iconatlas.h"
+
+const std::string IconAtlas::STAMP_OPTION ("tEXt::tvfamily-stamp");
+const std::string IconAtlas::TEMP_EXTENSION (".tmp");
+
+IconAtlas::IconAtlas (const std::filesystem::path& directory):
+    directory (directory), icons ()
+{
+    if (directory.empty ()) {
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories (directory, ec);
+    if (ec) {
+        std::cerr << "cannot create icon directory " << directory << ": "
+            << ec.message () << std::endl;
+        this->directory.clear ();
+    }
+}
+
+IconAtlas::~IconAtlas ()
+{}
+
+Glib::RefPtr<Gdk::Pixbuf> IconAtlas::get (const std::filesystem::path& file,
+                                          int width,
+                                          int height)
+{
+    auto key = file.string () + "@" + std::to_string (width) + "x"
+        + std::to_string (height);
+    auto it = icons.find (key);
+    if (it != icons.end ()) {
+        return it->second;
+    }
+
+    // Look for the image saved by a previous run
+    Glib::RefPtr<Gdk::Pixbuf> pixbuf;
+    auto stamp = get_stamp (file);
+    std::filesystem::path path;
+    if (not directory.empty () and not stamp.empty ()) {
+        auto absolute = std::filesystem::absolute (file).string ()
+            + "@" + std::to_string (width) + "x" + std::to_string (height);
+        auto checksum = g_compute_checksum_for_string (
+            G_CHECKSUM_SHA1, absolute.c_str (), absolute.size ());
+        path = directory / (std::string (checksum) + ".png");
+        g_free (checksum);
+        pixbuf = load (path, stamp);
+    }
+
+    if (not pixbuf) {
+        pixbuf = Gdk::Pixbuf::create_from_file (file, width, height, true);
+        if (not path.empty ()) {
+            save (path, pixbuf, stamp);
+        }
+    }
+    icons.emplace (key, pixbuf);
+    return pixbuf;
+}
+
+std::string IconAtlas::get_stamp (const std::filesystem::path& file)
+{
+    std::error_code ec;
+    auto time = std::filesystem::last_write_time (file, ec);
+    if (ec) {
+        return "";
+    }
+    auto size = std::filesystem::file_size (file, ec);
+    if (ec) {
+        return "";
+    }
+    return std::to_string (time.time_since_epoch ().count ()) + ":"
+        + std::to_string (size);
+}
+
+Glib::RefPtr<Gdk::Pixbuf> IconAtlas::load (const std::filesystem::path& path,
+                                           const std::string& stamp)
+{
+    std::error_code ec;
+    if (not std::filesystem::exists (path, ec)) {
+        return Glib::RefPtr<Gdk::Pixbuf> ();
+    }
+    try {
+        auto pixbuf = Gdk::Pixbuf::create_from_file (path);
+        if (pixbuf->get_option (STAMP_OPTION) == stamp) {
+            return pixbuf;
+        }
+    } catch (Glib::Error& e) {
+        // Broken file, it's replaced
+    }
+    return Glib::RefPtr<Gdk::Pixbuf> ();
+}
+
+void IconAtlas::save (const std::filesystem::path& path,
+                      const Glib::RefPtr<Gdk::Pixbuf>& pixbuf,
+                      const std::string& stamp)
+{
+    // Write to a temporary name, so that a crash never leaves a partial file
+    auto temp_path = path;
+    temp_path += TEMP_EXTENSION;
+    std::error_code ec;
+    try {
+        pixbuf->save (temp_path, "png",
+                      std::vector<Glib::ustring> {STAMP_OPTION},
+                      std::vector<Glib::ustring> {stamp});
+    } catch (Glib::Error& e) {
+        std::cerr << "cannot save icon " << path << ": " << e.what ()
+            << std::endl;
+        std::filesystem::remove (temp_path, ec);
+        return;
+    }
+    std::filesystem::rename (temp_path, path, ec);
+    if (ec) {
+        std::cerr << "cannot save icon " << path << ": " << ec.message ()
+            << std::endl;
+        std::filesystem::remove (temp_path, ec);
+    }
+}
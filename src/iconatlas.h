@@ -0,0 +1,84 @@
+/*
+iconatlas.h - Rendered icons, shared by all the widgets.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ICONATLAS_H
+#define ICONATLAS_H
+
+#include <filesystem>
+#include <gdkmm/pixbuf.h>
+#include <string>
+#include <unordered_map>
+
+/* Render each vector image (icon, logo) once per size, and share the
+   result among all the widgets that show it.
+
+   The rendered images are also saved as PNG files in a directory, so that
+   the next runs load them instead of rendering them again. Each file keeps
+   the modification time and size of its source, and it's rendered again
+   when they change. With an empty directory, nothing is saved. Use it
+   only from the main thread. */
+class IconAtlas {
+
+    private:
+
+        // Option of the PNG files with the version of their source
+        static const std::string STAMP_OPTION;
+
+        // Extension of the files being written
+        static const std::string TEMP_EXTENSION;
+
+        // Directory with the rendered images, empty if not saved
+        std::filesystem::path directory;
+
+        // The rendered images, by source and size
+        std::unordered_map<std::string, Glib::RefPtr<Gdk::Pixbuf> > icons;
+
+    public:
+
+        IconAtlas (const std::filesystem::path& directory);
+        ~IconAtlas ();
+
+        /* Return an image rendered at a size, keeping its aspect ratio. A
+           size of -1 is computed from the other one. Throw a Glib::Error
+           if the image cannot be loaded. */
+        Glib::RefPtr<Gdk::Pixbuf> get (const std::filesystem::path& file,
+                                       int width,
+                                       int height);
+
+    private:
+
+        /* Return the version of a file (its modification time and size), or
+           an empty string if it cannot be read. */
+        static std::string get_stamp (const std::filesystem::path& file);
+
+        // Load a saved image, or return null if missing or outdated
+        Glib::RefPtr<Gdk::Pixbuf> load (const std::filesystem::path& path,
+                                        const std::string& stamp);
+
+        // Save a rendered image
+        void save (const std::filesystem::path& path,
+                   const Glib::RefPtr<Gdk::Pixbuf>& pixbuf,
+                   const std::string& stamp);
+
+};
+
+#endif
@@ -0,0 +1,245 @@
+/*
+imagecache.cpp - Cache of the downloaded pictures on disk.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <glib.h>
+#include <iostream>
+#include <system_error>
+#include <vector>
+
+#include "imagecache.h"
+
+const std::string ImageCache::META_EXTENSION (".meta");
+const std::string ImageCache::TEMP_EXTENSION (".tmp");
+
+ImageCache::ImageCache (const std::filesystem::path& directory,
+                        std::uintmax_t max_size):
+    directory (directory), max_size (max_size), size (0), enabled (true),
+    items (), lru (), temp_counter (0), mutex ()
+{
+    std::error_code ec;
+    std::filesystem::create_directories (directory, ec);
+    if (ec) {
+        std::cerr << "cannot create cache directory " << directory << ": "
+            << ec.message () << std::endl;
+        enabled = false;
+    } else {
+        load ();
+    }
+}
+
+ImageCache::~ImageCache ()
+{}
+
+std::string ImageCache::get_name (const std::string& key)
+{
+    auto checksum = g_compute_checksum_for_string (
+        G_CHECKSUM_SHA1, key.c_str (), key.size ());
+    std::string name (checksum);
+    g_free (checksum);
+    return name;
+}
+
+void ImageCache::load ()
+{
+    struct Found {
+        std::string name;
+        std::uintmax_t size;
+        std::filesystem::file_time_type time;
+    };
+    std::vector<Found> found;
+    std::error_code ec;
+
+    for (auto& f: std::filesystem::directory_iterator (directory, ec)) {
+        if (not f.is_regular_file (ec)) {
+            continue;
+        }
+        auto path = f.path ();
+        auto extension = path.extension ().string ();
+        if (extension == TEMP_EXTENSION) {
+            // Left by an interrupted download
+            std::filesystem::remove (path, ec);
+        } else if (extension == META_EXTENSION) {
+            // Remove the metadata of missing pictures
+            auto picture = path;
+            picture.replace_extension ();
+            if (not std::filesystem::exists (picture, ec)) {
+                std::filesystem::remove (path, ec);
+            }
+        } else {
+            // A picture, it's only valid along with its metadata
+            auto name = path.filename ().string ();
+            std::ifstream meta (directory / (name + META_EXTENSION));
+            Item item;
+            if (not meta or not std::getline (meta, item.etag)
+                or not std::getline (meta, item.last_modified))
+            {
+                std::filesystem::remove (path, ec);
+                continue;
+            }
+            item.size = f.file_size (ec);
+            found.push_back ({name, item.size, f.last_write_time (ec)});
+            items.emplace (name, std::move (item));
+        }
+    }
+
+    // The modification time of a picture is the time it was last used
+    std::sort (found.begin (), found.end (),
+        [] (const Found& a, const Found& b) { return a.time > b.time; });
+    for (auto& f: found) {
+        items[f.name].lru = lru.insert (lru.end (), f.name);
+        size += f.size;
+    }
+
+    std::lock_guard<std::mutex> lock (mutex);
+    evict ();
+}
+
+bool ImageCache::lookup (const std::string& key, Entry& entry)
+{
+    if (not enabled) {
+        return false;
+    }
+    auto name = get_name (key);
+    std::lock_guard<std::mutex> lock (mutex);
+    auto it = items.find (name);
+    if (it == items.end ()) {
+        return false;
+    }
+    lru.splice (lru.begin (), lru, it->second.lru);
+    entry.path = directory / name;
+    entry.etag = it->second.etag;
+    entry.last_modified = it->second.last_modified;
+
+    // Remember the use for the next runs
+    std::error_code ec;
+    std::filesystem::last_write_time (
+        entry.path, std::filesystem::file_time_type::clock::now (), ec);
+    return true;
+}
+
+std::filesystem::path ImageCache::get_temp_path (const std::string& key)
+{
+    if (not enabled) {
+        return std::filesystem::path ();
+    }
+    std::lock_guard<std::mutex> lock (mutex);
+    return directory / (get_name (key) + "." + std::to_string (temp_counter++)
+        + TEMP_EXTENSION);
+}
+
+void ImageCache::store (const std::string& key,
+                        const std::filesystem::path& temp_path,
+                        const std::string& etag,
+                        const std::string& last_modified)
+{
+    auto name = get_name (key);
+    auto path = directory / name;
+    auto meta_temp_path = temp_path;
+    meta_temp_path.replace_extension (META_EXTENSION + TEMP_EXTENSION);
+    std::error_code ec;
+
+    // Write the metadata aside
+    std::ofstream meta (meta_temp_path);
+    meta << etag << '\n' << last_modified << '\n';
+    meta.close ();
+    if (not meta) {
+        std::cerr << "cannot write cache file " << meta_temp_path
+            << std::endl;
+        std::filesystem::remove (meta_temp_path, ec);
+        discard (temp_path);
+        return;
+    }
+
+    /* Replace the picture and then its metadata. If we stop in between,
+       the new picture has old validators and it's downloaded again. */
+    std::lock_guard<std::mutex> lock (mutex);
+    std::filesystem::rename (temp_path, path, ec);
+    if (not ec) {
+        std::filesystem::rename (
+            meta_temp_path, directory / (name + META_EXTENSION), ec);
+    }
+    if (ec) {
+        std::cerr << "cannot store " << path << " in cache: " << ec.message ()
+            << std::endl;
+        std::filesystem::remove (temp_path, ec);
+        std::filesystem::remove (meta_temp_path, ec);
+        if (items.count (name)) {
+            remove_files (name);
+        }
+        return;
+    }
+
+    // Update the bookkeeping
+    auto file_size = std::filesystem::file_size (path, ec);
+    if (ec) {
+        file_size = 0;
+    }
+    auto it = items.find (name);
+    if (it != items.end ()) {
+        size -= it->second.size;
+        lru.erase (it->second.lru);
+    } else {
+        it = items.emplace (name, Item ()).first;
+    }
+    it->second.lru = lru.insert (lru.begin (), name);
+    it->second.size = file_size;
+    it->second.etag = etag;
+    it->second.last_modified = last_modified;
+    size += file_size;
+    evict ();
+}
+
+void ImageCache::discard (const std::filesystem::path& temp_path)
+{
+    std::error_code ec;
+    std::filesystem::remove (temp_path, ec);
+}
+
+void ImageCache::remove (const std::string& key)
+{
+    auto name = get_name (key);
+    std::lock_guard<std::mutex> lock (mutex);
+    if (items.count (name)) {
+        remove_files (name);
+    }
+}
+
+void ImageCache::evict ()
+{
+    while (size > max_size and not lru.empty ()) {
+        auto name = lru.back ();
+        remove_files (name);
+    }
+}
+
+void ImageCache::remove_files (const std::string& name)
+{
+    std::error_code ec;
+    std::filesystem::remove (directory / name, ec);
+    std::filesystem::remove (directory / (name + META_EXTENSION), ec);
+    auto it = items.find (name);
+    size -= it->second.size;
+    lru.erase (it->second.lru);
+    items.erase (it);
+}
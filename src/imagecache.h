@@ -0,0 +1,143 @@
+/*
+imagecache.h - Cache of the downloaded pictures on disk.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/* Keep the downloaded pictures on disk, so that they are revalidated with
+   the server (ETag and Last-Modified) instead of downloaded again.
+
+   Each picture is stored in a file named after the SHA-1 of its key, next
+   to a .meta file with its validators. The files are written to a
+   temporary name and renamed, so a crash never leaves a partial picture.
+   When the cache grows over its limit, the least recently used pictures
+   are removed. All the methods are thread safe. */
+class ImageCache {
+
+    public:
+
+        // A cached picture
+        struct Entry {
+
+            // File with the picture
+            std::filesystem::path path;
+
+            // Validators returned by the server with the picture
+            std::string etag;
+            std::string last_modified;
+        };
+
+    private:
+
+        // Extensions of the metadata and the temporary files
+        static const std::string META_EXTENSION;
+        static const std::string TEMP_EXTENSION;
+
+        // Bookkeeping of a cached picture
+        struct Item {
+
+            // Position in the LRU list
+            std::list<std::string>::iterator lru;
+
+            // Size of the picture file
+            std::uintmax_t size;
+
+            // Validators of the picture
+            std::string etag;
+            std::string last_modified;
+        };
+
+        // Directory with the files
+        std::filesystem::path directory;
+
+        // Maximum size of the pictures, in bytes
+        std::uintmax_t max_size;
+
+        // Current size of the pictures, in bytes
+        std::uintmax_t size;
+
+        // False if the directory is unusable
+        bool enabled;
+
+        // Cached pictures, by file name
+        std::unordered_map<std::string, Item> items;
+
+        // File names, from the most to the least recently used
+        std::list<std::string> lru;
+
+        // Counter to make the temporary files unique
+        unsigned long temp_counter;
+
+        // Mutex to protect all of the above
+        std::mutex mutex;
+
+    public:
+
+        ImageCache (const std::filesystem::path& directory,
+                    std::uintmax_t max_size);
+        ~ImageCache ();
+
+        /* Look for the picture of a key. Return false if it isn't cached.
+           The picture becomes the most recently used. */
+        bool lookup (const std::string& key, Entry& entry);
+
+        /* Return a new temporary file to download the picture of a key, or
+           an empty path if the cache is disabled. */
+        std::filesystem::path get_temp_path (const std::string& key);
+
+        /* Move a downloaded picture, in a file returned by get_temp_path,
+           into the cache. */
+        void store (const std::string& key,
+                    const std::filesystem::path& temp_path,
+                    const std::string& etag,
+                    const std::string& last_modified);
+
+        // Remove a temporary file that won't be stored.
+        void discard (const std::filesystem::path& temp_path);
+
+        // Remove the picture of a key (when its file is not valid).
+        void remove (const std::string& key);
+
+    private:
+
+        // Return the file name of the picture of a key.
+        static std::string get_name (const std::string& key);
+
+        // Read the cached pictures of a previous run.
+        void load ();
+
+        // Remove the least recently used pictures until the size fits.
+        void evict ();
+
+        // Remove the files of a picture. The mutex must be locked.
+        void remove_files (const std::string& name);
+
+};
+
+#endif
@@ -0,0 +1,154 @@
+/*
+jsonbench.cpp - Benchmark of the decoders of the lists of medias.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <rapidjson/document.h>
+#include <rapidjson/reader.h>
+#include <string>
+#include <vector>
+
+#include "mediashandler.h"
+#include "mediasresult.h"
+
+// Size of a large list of medias, and of the benchmark
+static const int DEFAULT_ENTRIES = 10000;
+static const int DEFAULT_ITERATIONS = 50;
+
+// Build a response of gettop with some movies and some episodes
+static std::string
+create_payload (int entries)
+{
+    std::string payload = "{\"code\":0,\"top\":[";
+    for (int i = 0; i < entries; i++) {
+        if (i) {
+            payload += ',';
+        }
+        auto id = std::to_string (1000000 + i);
+        payload += "{\"title_id\":\"tt" + id + "\",\"title\":\"Title of the "
+            "media number " + std::to_string (i) + "\",\"rating\":\""
+            + std::to_string (i % 10) + "." + std::to_string (i % 7) + "\"";
+        if (i % 3 == 0) {
+            payload += ",\"season\":" + std::to_string (1 + i % 12)
+                + ",\"episode\":" + std::to_string (1 + i % 24);
+        }
+        payload += '}';
+    }
+    payload += "]}";
+    return payload;
+}
+
+// Decode the medias from a document, as it was done before the SAX handler
+static bool
+decode_document (rapidjson::Document& d, MediasResult& result)
+{
+    if (d.HasParseError () or not d.IsObject () or not d.HasMember ("code")
+        or not d.HasMember ("top") or not d["top"].IsArray ())
+    {
+        return false;
+    }
+    auto& top = d["top"];
+    for (rapidjson::SizeType i = 0; i < top.Size (); i++) {
+        auto& m = top[i];
+        Media media;
+        auto& id = m["title_id"];
+        media.set_title_id (id.GetString (), id.GetStringLength ());
+        auto& title = m["title"];
+        media.set_title (title.GetString (), title.GetStringLength ());
+        auto& rating = m["rating"];
+        media.set_rating (rating.GetString (), rating.GetStringLength ());
+        if (m.HasMember ("season")) {
+            media.set_season (m["season"].GetInt ());
+            media.set_episode (m["episode"].GetInt ());
+        }
+        result.add (std::move (media));
+    }
+    return true;
+}
+
+/* Return the mean time of a decoder in microseconds. It decodes a new copy
+   of the payload each time (the in place parsers write on it); the copies
+   are made before measuring. */
+template <typename F>
+static double
+measure (const std::string& payload, int iterations, int entries, F f)
+{
+    std::vector<std::string> copies (iterations, payload);
+    auto start = std::chrono::steady_clock::now ();
+    for (auto& copy: copies) {
+        MediasResult result;
+        if (not f (&copy[0], result) or result.size () != entries) {
+            std::cerr << "The medias weren't decoded" << std::endl;
+            exit (EXIT_FAILURE);
+        }
+    }
+    std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now () - start;
+    return elapsed.count () / iterations;
+}
+
+int
+main (int argc, char* argv[])
+{
+    if (argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " [ENTRIES [ITERATIONS]]"
+            << std::endl;
+        return EXIT_FAILURE;
+    }
+    int entries = argc > 1 ? atoi (argv[1]) : DEFAULT_ENTRIES;
+    int iterations = argc > 2 ? atoi (argv[2]) : DEFAULT_ITERATIONS;
+    if (entries <= 0 or iterations <= 0) {
+        std::cerr << "Entries and iterations must be positive" << std::endl;
+        return EXIT_FAILURE;
+    }
+    auto payload = create_payload (entries);
+    std::cout << entries << " medias, " << payload.size () << " bytes"
+        << std::endl;
+
+    auto t = measure (payload, iterations, entries,
+        [] (char* json, MediasResult& result) {
+            rapidjson::Document d;
+            d.Parse (json);
+            return decode_document (d, result);
+        });
+    std::cout << "  DOM Parse: " << t << " us" << std::endl;
+
+    t = measure (payload, iterations, entries,
+        [] (char* json, MediasResult& result) {
+            rapidjson::Document d;
+            d.ParseInsitu (json);
+            return decode_document (d, result);
+        });
+    std::cout << "  DOM ParseInsitu: " << t << " us" << std::endl;
+
+    t = measure (payload, iterations, entries,
+        [] (char* json, MediasResult& result) {
+            MediasHandler handler ("top", result);
+            rapidjson::InsituStringStream stream (json);
+            rapidjson::Reader reader;
+            return reader.Parse<rapidjson::kParseInsituFlag> (
+                stream, handler) and handler.get_has_code ();
+        });
+    std::cout << "  SAX MediasHandler: " << t << " us" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -28,13 +28,24 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #include <string>
 
 #include "config.h"
+#include "curl.h"
+#include "framescheduler.h"
+#include "mediasview.h"
+#include "requestmanager.h"
 #include "viewcontroller.h"
 
 // Short options:
 //   * h: help
 //   * v: version
 //   * a: server address
-const char* OPTSTRING = "hva:";
+//   * w: number of request workers
+//   * 2: use HTTP/2
+//   * p: rows of posters loaded beyond the screen
+//   * f: time of a frame to update the interface
+//   * t: print the startup timeline
+//   * s: print the counters on exit
+//   * c: file with the certificates of the server
+const char* OPTSTRING = "hva:w:2p:f:tsc:";
 
 // Print help message and exits
 static void
@@ -45,7 +56,21 @@ print_help ()
 "Options:\n"
 "  -h, --help                  Show this message and exit.\n"
 "  -v, --version               Show version information.\n"
-"  -a ADDR, --address ADDR     Server address.\n\n"
+"  -a ADDR, --address ADDR     Server address.\n"
+"  -w NUM, --workers NUM       Number of threads to run the requests\n"
+"                              (default: number of cores).\n"
+"  -2, --http2                 Use HTTP/2 if the server supports it (the\n"
+"                              requests are multiplexed with https only).\n"
+"  -c FILE, --cacert FILE      Verify the server with the certificates of\n"
+"                              FILE.\n"
+"  -p ROWS, --prefetch ROWS    Rows of posters loaded beyond the screen\n"
+"                              (default: 2).\n"
+"  -f USEC, --frame-budget USEC\n"
+"                              Time of each frame to update the interface,\n"
+"                              in microseconds (default: 4000).\n"
+"  -t, --trace-startup         Print the startup timeline.\n"
+"  -s, --stats                 Print the counters of the requests and of\n"
+"                              the frames on exit.\n\n"
 "Report bugs to:\n"
 "Antonio Serrano Hernandez (" PACKAGE_BUGREPORT ")"
         << std::endl;
@@ -67,17 +92,41 @@ PACKAGE_STRING "\n"
 
 // Parse the command line arguments
 static void
-parse_args (int argc, char **argv, std::string& server_address)
+parse_args (int argc,
+            char **argv,
+            std::string& server_address,
+            unsigned int& num_workers,
+            bool& http2,
+            int& prefetch_rows,
+            long& frame_budget,
+            bool& trace_startup,
+            bool& stats,
+            std::string& ca_file)
 {
     struct option long_opts[] = {
         {"help", no_argument, 0, 'h'},
         {"version", no_argument, 0, 'v'},
         {"address", required_argument, 0, 'a'},
+        {"workers", required_argument, 0, 'w'},
+        {"http2", no_argument, 0, '2'},
+        {"prefetch", required_argument, 0, 'p'},
+        {"frame-budget", required_argument, 0, 'f'},
+        {"trace-startup", no_argument, 0, 't'},
+        {"stats", no_argument, 0, 's'},
+        {"cacert", required_argument, 0, 'c'},
         {0, 0, 0, 0}
     };
     int o;
+    char *end;
 
     server_address = "";
+    num_workers = RequestManager::get_default_workers ();
+    http2 = false;
+    prefetch_rows = MediasView::DEFAULT_PREFETCH_ROWS;
+    frame_budget = FrameScheduler::DEFAULT_FRAME_BUDGET;
+    trace_startup = false;
+    stats = false;
+    ca_file = "";
     do {
         o = getopt_long(argc, argv, OPTSTRING, long_opts, 0);
         switch (o) {
@@ -88,6 +137,36 @@ parse_args (int argc, char **argv, std::string& server_address)
             case 'a':
                 server_address = optarg;
                 break;
+            case 'w':
+                num_workers = strtoul (optarg, &end, 10);
+                if (*end or not num_workers) {
+                    errx (1, "error: wrong number of workers '%s'", optarg);
+                }
+                break;
+            case '2':
+                http2 = true;
+                break;
+            case 'p':
+                prefetch_rows = strtol (optarg, &end, 10);
+                if (*end or prefetch_rows < 0) {
+                    errx (1, "error: wrong number of rows '%s'", optarg);
+                }
+                break;
+            case 'f':
+                frame_budget = strtol (optarg, &end, 10);
+                if (*end or frame_budget <= 0) {
+                    errx (1, "error: wrong frame budget '%s'", optarg);
+                }
+                break;
+            case 't':
+                trace_startup = true;
+                break;
+            case 's':
+                stats = true;
+                break;
+            case 'c':
+                ca_file = optarg;
+                break;
             case '?':
                 exit (1);
             default:
@@ -103,15 +182,30 @@ int
 main (int argc, char *argv[])
 {
     std::string server_address;
+    unsigned int num_workers;
+    bool http2;
+    int prefetch_rows;
+    long frame_budget;
+    bool trace_startup;
+    bool stats;
+    std::string ca_file;
 
     // Parse the command line arguments.
-    parse_args (argc, argv, server_address);
+    parse_args (argc, argv, server_address, num_workers, http2,
+                prefetch_rows, frame_budget, trace_startup, stats, ca_file);
+    Curl::set_ca_file (ca_file);
 
     // Create the Gtk Application and the MainWindow
     auto app = Gtk::Application::create ();
-    ViewController controller (app, server_address);
-
-    // Run the Gtk Application       
-    return app->run (controller.get_window ());    
+    ViewController controller (app, server_address, num_workers, http2,
+                               prefetch_rows, frame_budget, trace_startup);
+
+    // Run the Gtk Application
+    auto status = app->run (controller.get_window ());
+    if (stats) {
+        controller.get_core ().get_request_manager ().print_stats (std::cerr);
+        controller.get_scheduler ().print_stats (std::cerr);
+    }
+    return status;
 }
 
@@ -0,0 +1,58 @@
+/*
+mainqueue.cpp - Queue of jobs to run in the main loop.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "mainqueue.h"
+
+MainQueue::MainQueue (FrameScheduler& scheduler):
+    scheduler (scheduler), dispatcher (), jobs (), mutex ()
+{
+    dispatcher.connect (sigc::mem_fun (*this, &MainQueue::on_dispatch));
+}
+
+MainQueue::~MainQueue ()
+{}
+
+void MainQueue::push (const std::function<void ()>& job)
+{
+    auto wake_up = false;
+    {
+        // Wake the main loop up only if it has nothing to take yet
+        std::lock_guard<std::mutex> lock(mutex);
+        wake_up = jobs.empty ();
+        jobs.push_back (job);
+    }
+    if (wake_up) {
+        dispatcher.emit ();
+    }
+}
+
+void MainQueue::on_dispatch ()
+{
+    std::deque<std::function<void ()> > batch;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batch.swap (jobs);
+    }
+    for (auto& job: batch) {
+        scheduler.schedule (job);
+    }
+}
@@ -0,0 +1,73 @@
+/*
+mainqueue.h - Queue of jobs to run in the main loop.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MAINQUEUE_H
+#define MAINQUEUE_H
+
+#include <deque>
+#include <functional>
+#include <glibmm/dispatcher.h>
+#include <mutex>
+
+#include "framescheduler.h"
+
+/* Queue of jobs posted from any thread to run in the main loop, such as
+   passing the results of the requests to the views.
+
+   A single Glib::Dispatcher wakes the main loop up, however many jobs are
+   posted. The jobs are then passed to the frame scheduler, that runs them
+   in the next frames within their time budget, so that a burst of results
+   doesn't freeze the interface. */
+class MainQueue {
+
+    private:
+
+        // Scheduler of the jobs in the main thread
+        FrameScheduler& scheduler;
+
+        // Wakes the main loop up from other threads
+        Glib::Dispatcher dispatcher;
+
+        // Jobs waiting for the main loop
+        std::deque<std::function<void ()> > jobs;
+
+        // Mutex to protect the jobs
+        std::mutex mutex;
+
+    public:
+
+        // Create the queue. It must be created in the main thread.
+        MainQueue (FrameScheduler& scheduler);
+        ~MainQueue ();
+
+        // Post a job to run in the main loop. It can be called from any
+        // thread.
+        void push (const std::function<void ()>& job);
+
+    private:
+
+        // Pass the jobs to the scheduler
+        void on_dispatch ();
+
+};
+
+#endif
@@ -0,0 +1,63 @@
+/*
+media.cpp - A media (a movie or an episode) from the server.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <functional>
+
+#include "media.h"
+
+Media::Media ():
+    title_id (), title (), rating (), season (-1), episode (-1)
+{}
+
+Media::~Media ()
+{}
+
+std::string Media::to_string () const
+{
+    if (season < 0 and episode < 0) {
+        return title;
+    } else {
+        char s[32];
+        snprintf (s, sizeof (s), " %dx%02d", season, episode);
+        return title + s;
+    }
+}
+
+bool Media::operator== (const Media& other) const
+{
+    return title_id == other.title_id and season == other.season
+        and episode == other.episode;
+}
+
+bool Media::is_identical (const Media& other) const
+{
+    return *this == other and title == other.title
+        and rating == other.rating;
+}
+
+size_t Media::Hash::operator() (const Media& media) const
+{
+    auto h = std::hash<std::string> () (media.title_id);
+    h = h * 31 + std::hash<int> () (media.season);
+    return h * 31 + std::hash<int> () (media.episode);
+}
@@ -0,0 +1,87 @@
+/*
+media.h - A media (a movie or an episode) from the server.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MEDIA_H
+#define MEDIA_H
+
+#include <string>
+
+class Media {
+
+    private:
+
+        // Identifier of the title
+        std::string title_id;
+
+        // Name of the title
+        std::string title;
+
+        // Rating of the title
+        std::string rating;
+
+        // Season and episode (-1 if the media is not an episode)
+        int season;
+        int episode;
+
+    public:
+
+        Media ();
+        ~Media ();
+
+        // Getters
+        inline const std::string& get_title_id () const { return title_id; }
+        inline const std::string& get_title () const { return title; }
+        inline const std::string& get_rating () const { return rating; }
+        inline int get_season () const { return season; }
+        inline int get_episode () const { return episode; }
+
+        // Setters
+        inline void set_title_id (const char* s, size_t length)
+            { title_id.assign (s, length); }
+        inline void set_title (const char* s, size_t length)
+            { title.assign (s, length); }
+        inline void set_rating (const char* s, size_t length)
+            { rating.assign (s, length); }
+        inline void set_season (int season) { this->season = season; }
+        inline void set_episode (int episode) { this->episode = episode; }
+
+        // Return true if this is an episode of a series.
+        inline bool is_episode () const
+            { return season > 0 and episode > 0; }
+
+        // Return the string representation of this media.
+        std::string to_string () const;
+
+        // Return true if both medias represent the same.
+        bool operator== (const Media& other) const;
+
+        // Return true if both medias represent the same with the same data.
+        bool is_identical (const Media& other) const;
+
+        // Hash function consistent with operator==.
+        struct Hash {
+            size_t operator() (const Media& media) const;
+        };
+
+};
+
+#endif
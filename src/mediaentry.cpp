@@ -0,0 +1,64 @@
+/*
+mediaentry.cpp - An entry of the medias box.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "mediaentry.h"
+
+MediaEntry::MediaEntry (int poster_w, int poster_h):
+    media (), index (NONE), overlay (), button (), image (), title_label ()
+{
+    overlay.add (button);
+
+    // The title goes at the bottom of the poster
+    title_label.get_style_context ()->add_class ("media-label");
+    title_label.set_halign (Gtk::ALIGN_CENTER);
+    title_label.set_valign (Gtk::ALIGN_END);
+    title_label.set_line_wrap (true);
+    title_label.set_justify (Gtk::JUSTIFY_CENTER);
+    overlay.add_overlay (title_label);
+
+    image.set_size_request (poster_w, poster_h);
+    button.add (image);
+    button.get_style_context ()->add_class ("picture-button");
+}
+
+MediaEntry::~MediaEntry ()
+{}
+
+bool MediaEntry::bind (const Media& media, size_t index)
+{
+    auto same_title = this->media.get_title_id () == media.get_title_id ()
+        and image.get_storage_type () != Gtk::IMAGE_EMPTY;
+    this->media = media;
+    this->index = index;
+    title_label.set_text (media.to_string ());
+    if (same_title) {
+        return false;
+    }
+    image.clear ();
+    return true;
+}
+
+void MediaEntry::set_poster_size (int w, int h)
+{
+    image.set_size_request (w, h);
+    image.clear ();
+}
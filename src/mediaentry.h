@@ -0,0 +1,93 @@
+/*
+mediaentry.h - An entry of the medias box.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MEDIAENTRY_H
+#define MEDIAENTRY_H
+
+#include <gdkmm/pixbuf.h>
+#include <gtkmm/button.h>
+#include <gtkmm/image.h>
+#include <gtkmm/label.h>
+#include <gtkmm/overlay.h>
+
+#include "media.h"
+
+class MediaEntry {
+
+    private:
+
+        // The media shown by this entry.
+        Media media;
+
+        // Index of the media in its list, or NONE if the entry is unused.
+        size_t index;
+
+        // Overlay to put the title over the poster.
+        Gtk::Overlay overlay;
+
+        // The GTK button.
+        Gtk::Button button;
+
+        // The poster of the media.
+        Gtk::Image image;
+
+        // The title of the media.
+        Gtk::Label title_label;
+
+    public:
+
+        // Index of an unused entry
+        static const size_t NONE = static_cast<size_t> (-1);
+
+        MediaEntry (int poster_w, int poster_h);
+        ~MediaEntry ();
+
+        /* Show another media. The index is the position of the media in
+           its list. The poster is kept if the title is the same. Return
+           true if the entry has no poster, so that it must be set. */
+        bool bind (const Media& media, size_t index);
+
+        // Mark the entry as unused.
+        inline void unbind () { index = NONE; }
+
+        // Return the media.
+        inline const Media& get_media () const { return media; }
+
+        // Return the index of the media, or NONE if the entry is unused.
+        inline size_t get_index () const { return index; }
+
+        // Set the size of the poster, clearing the poster.
+        void set_poster_size (int w, int h);
+
+        // Return the widget to put in a container.
+        inline Gtk::Overlay& get_widget () { return overlay; }
+
+        // Return the GTK button.
+        inline Gtk::Button& get_button () { return button; }
+
+        // Set the poster, already scaled to the entry size.
+        inline void set_poster (const Glib::RefPtr<Gdk::Pixbuf>& poster)
+            { image.set (poster); }
+
+};
+
+#endif
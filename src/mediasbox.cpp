@@ -0,0 +1,286 @@
+/*
+mediasbox.cpp - Grid of medias with their posters.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <unordered_map>
+#include <gtkmm/adjustment.h>
+#include <gtkmm/scrollbar.h>
+
+#include "mediasbox.h"
+
+MediasBox::MediasBox (int cols, int prefetch_rows):
+    cols (cols), prefetch_rows (prefetch_rows), poster_w (-1), poster_h (-1),
+    cell_w (1), cell_h (1), box (), layout (), medias (), entries (),
+    pool_rows (0), setting (false)
+{
+    box.signal_show ().connect (sigc::mem_fun (*this, &MediasBox::on_show));
+    box.set_policy (Gtk::POLICY_NEVER, Gtk::POLICY_AUTOMATIC);
+    box.add (layout);
+
+    // Scroll to the entry that gets the focus
+    layout.set_focus_vadjustment (box.get_vadjustment ());
+}
+
+MediasBox::~MediasBox ()
+{}
+
+void MediasBox::on_show ()
+{
+    box.get_vscrollbar ()->hide ();
+}
+
+void MediasBox::set_poster_size (int w, int h)
+{
+    if (w == poster_w and h == poster_h) {
+        return;
+    }
+    poster_w = w;
+    poster_h = h;
+
+    // The entries are placed again at the new size
+    for (auto& e: entries) {
+        e->set_poster_size (w, h);
+        e->unbind ();
+        e->get_widget ().hide ();
+    }
+}
+
+MediasBox::SetResult MediasBox::set (const std::vector<Media>& medias)
+{
+    if (std::equal (medias.begin (), medias.end (), this->medias.begin (),
+                    this->medias.end (),
+                    [] (const Media& a, const Media& b)
+                    { return a.is_identical (b); }))
+    {
+        return UNCHANGED;
+    }
+
+    // Match the new medias with the old ones, the first ones first
+    std::unordered_map<Media, std::vector<size_t>, Media::Hash> old_indexes;
+    for (auto i = this->medias.size (); i-- > 0;) {
+        old_indexes[this->medias[i]].push_back (i);
+    }
+    std::vector<size_t> new_indexes (this->medias.size (), MediaEntry::NONE);
+    auto kept = false;
+    for (size_t j = 0; j < medias.size (); j++) {
+        auto it = old_indexes.find (medias[j]);
+        if (it != old_indexes.end () and not it->second.empty ()) {
+            new_indexes[it->second.back ()] = j;
+            it->second.pop_back ();
+            kept = true;
+        }
+    }
+    this->medias = medias;
+
+    setting = true;
+    if (kept) {
+        move_entries (new_indexes);
+        setting = false;
+        return UPDATED;
+    }
+
+    // Nothing to keep, start again from the top
+    for (auto& e: entries) {
+        e->unbind ();
+        e->get_widget ().hide ();
+    }
+    box.get_vadjustment ()->set_value (0);
+    update_size ();
+    setting = false;
+    return REPLACED;
+}
+
+void MediasBox::move_entries (const std::vector<size_t>& new_indexes)
+{
+    update_size ();
+    if (not pool_rows) {
+        return;
+    }
+
+    /* The entries whose media stays near the screen go to the slot of the
+       new index, where they keep their poster. The rows near the screen
+       use different slots, so they don't collide. */
+    size_t first_row, last_row;
+    get_bound_rows (first_row, last_row);
+    std::vector<std::unique_ptr<MediaEntry> > pool (entries.size ());
+    std::vector<std::unique_ptr<MediaEntry> > spare;
+    for (auto& e: entries) {
+        auto i = e->get_index ();
+        auto j = i == MediaEntry::NONE ? i : new_indexes[i];
+        if (j != MediaEntry::NONE and first_row * cols <= j
+            and j < last_row * cols)
+        {
+            // The data of the media may have changed, even in its place
+            e->bind (medias[j], j);
+            if (i != j) {
+                layout.move (e->get_widget (), (j % cols) * cell_w,
+                             (j / cols) * cell_h);
+            }
+            pool[get_slot (j)] = std::move (e);
+        } else {
+            spare.push_back (std::move (e));
+        }
+    }
+
+    // The rest of the entries are free for the new medias
+    for (auto& e: pool) {
+        if (not e) {
+            e = std::move (spare.back ());
+            spare.pop_back ();
+            e->unbind ();
+            e->get_widget ().hide ();
+        }
+    }
+    entries.swap (pool);
+}
+
+void MediasBox::get_bound_rows (size_t& first_row, size_t& last_row)
+{
+    // Rows on screen and within the margins
+    auto adjustment = box.get_vadjustment ();
+    auto top = adjustment->get_value ();
+    auto bottom = top + adjustment->get_page_size ();
+    size_t num_rows = (medias.size () + cols - 1) / cols;
+    size_t margin = prefetch_rows;
+    first_row = top / cell_h;
+    first_row = first_row > margin ? first_row - margin : 0;
+    last_row = std::min (
+        num_rows, static_cast<size_t> (bottom / cell_h) + 1 + margin);
+}
+
+void MediasBox::bind_visible (std::vector<size_t>& bound)
+{
+    if (setting or medias.empty ()) {
+        return;
+    }
+    update_size ();
+
+    // Take the entries of the rows that share their pool row
+    size_t first_row, last_row;
+    get_bound_rows (first_row, last_row);
+    for (auto r = first_row; r < last_row; r++) {
+        for (int c = 0; c < cols; c++) {
+            size_t i = r * cols + c;
+            auto& e = entries[get_slot (i)];
+            if (e->get_index () == i) {
+                continue;
+            }
+            if (i < medias.size ()) {
+                if (e->bind (medias[i], i)) {
+                    bound.push_back (i);
+                }
+                layout.move (e->get_widget (), c * cell_w, r * cell_h);
+                e->get_widget ().show ();
+            } else {
+                e->unbind ();
+                e->get_widget ().hide ();
+            }
+        }
+    }
+}
+
+void MediasBox::update_size ()
+{
+    // All the cells have the size of an entry on screen
+    int w = poster_w > 0 ? poster_w : 1;
+    int h = poster_h > 0 ? poster_h : 1;
+    for (auto& e: entries) {
+        if (e->get_index () != MediaEntry::NONE) {
+            auto& widget = e->get_widget ();
+            if (widget.get_allocated_height () > 1) {
+                w = widget.get_allocated_width ();
+                h = widget.get_allocated_height ();
+            }
+            break;
+        }
+    }
+
+    /* Enough rows to cover the screen and the margins at any offset. The
+       rows change their pool row when the pool grows or the cells change,
+       so all the entries are placed again. */
+    size_t rows = box.get_vadjustment ()->get_page_size () / h + 2
+        + 2 * prefetch_rows;
+    if (w != cell_w or h != cell_h or rows > pool_rows) {
+        cell_w = w;
+        cell_h = h;
+        for (auto& e: entries) {
+            e->unbind ();
+            e->get_widget ().hide ();
+        }
+    }
+    if (rows > pool_rows) {
+        for (auto i = entries.size (); i < rows * cols; i++) {
+            auto e = std::make_unique<MediaEntry> (poster_w, poster_h);
+            e->get_widget ().show_all ();
+            e->get_widget ().hide ();
+            layout.put (e->get_widget (), 0, 0);
+            entries.push_back (std::move (e));
+        }
+        pool_rows = rows;
+    }
+
+    // The layout has the size of the whole grid
+    size_t num_rows = (medias.size () + cols - 1) / cols;
+    layout.set_size (cols * cell_w, num_rows * cell_h);
+}
+
+MediaEntry* MediasBox::get_entry (size_t index)
+{
+    if (not pool_rows) {
+        return nullptr;
+    }
+    auto& e = entries[get_slot (index)];
+    return e->get_index () == index ? e.get () : nullptr;
+}
+
+void MediasBox::set_poster (const std::string& title_id,
+                            const Glib::RefPtr<Gdk::Pixbuf>& poster)
+{
+    for (auto& e: entries) {
+        if (e->get_index () != MediaEntry::NONE
+            and e->get_media ().get_title_id () == title_id)
+        {
+            e->set_poster (poster);
+        }
+    }
+}
+
+void MediasBox::get_visible_range (size_t& first, size_t& last)
+{
+    auto adjustment = box.get_vadjustment ();
+    auto top = adjustment->get_value ();
+    auto bottom = top + adjustment->get_page_size ();
+    size_t first_row = top / cell_h;
+    size_t last_row = bottom / cell_h + 1;
+    first = std::min (first_row * cols, medias.size ());
+    last = std::min (last_row * cols, medias.size ());
+}
+
+bool MediasBox::set_focus (int index)
+{
+    auto e = index < 0 ? nullptr : get_entry (index);
+    if (not e) {
+        return false;
+    }
+    e->get_button ().grab_focus ();
+    return true;
+}
@@ -0,0 +1,154 @@
+/*
+mediasbox.h - Grid of medias with their posters.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MEDIASBOX_H
+#define MEDIASBOX_H
+
+#include <gdkmm/pixbuf.h>
+#include <gtkmm/layout.h>
+#include <gtkmm/scrolledwindow.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "media.h"
+#include "mediaentry.h"
+
+class MediasBox {
+
+    private:
+
+        // Number of columns of the grid
+        int cols;
+
+        // Number of rows kept below and above the screen
+        int prefetch_rows;
+
+        // Size of the posters
+        int poster_w;
+        int poster_h;
+
+        // Size of a cell of the grid, measured from the entries
+        int cell_w;
+        int cell_h;
+
+        // Box to scroll the grid
+        Gtk::ScrolledWindow box;
+
+        // Area where the entries are placed at the position of their media
+        Gtk::Layout layout;
+
+        // List of the medias to show, in grid order
+        std::vector<Media> medias;
+
+        /* Pool of entries, row after row. The row r of the grid is shown
+           by the row r % pool_rows of the pool, so the entries are
+           recycled as the grid scrolls. */
+        std::vector<std::unique_ptr<MediaEntry> > entries;
+
+        // Number of rows of the pool
+        size_t pool_rows;
+
+        /* True while a new list is set. The resize of the layout calls
+           bind_visible back, when the entries still have the indexes of
+           the previous list. */
+        bool setting;
+
+    public:
+
+        // Result of setting a list of medias
+        enum SetResult {
+            UNCHANGED,  // Same list
+            UPDATED,    // Some medias kept, maybe at other positions
+            REPLACED    // No media kept
+        };
+
+        MediasBox (int cols, int prefetch_rows);
+        ~MediasBox ();
+
+        // Return the GTK box that contains the controls
+        inline Gtk::ScrolledWindow& get_box () { return box; }
+
+        // Set the size of the posters.
+        void set_poster_size (int w, int h);
+
+        // Return the size of the posters.
+        inline int get_poster_width () const { return poster_w; }
+        inline int get_poster_height () const { return poster_h; }
+
+        /* Set the list of medias. The medias kept from the previous list
+           move their entries, with their posters, to the new positions;
+           the new medias are shown when bind_visible is called. If no
+           media is kept, the box goes back to the top. */
+        SetResult set (const std::vector<Media>& medias);
+
+        /* Show the medias of the rows on screen and of the rows near it,
+           taking the entries of the rows far from it. Add to bound the
+           indexes of the medias that got an entry without poster. It
+           does nothing while a list is set. */
+        void bind_visible (std::vector<size_t>& bound);
+
+        // Set the poster of the entries of a title.
+        void set_poster (const std::string& title_id,
+                         const Glib::RefPtr<Gdk::Pixbuf>& poster);
+
+        // Return the number of medias.
+        inline size_t size () const { return medias.size (); }
+
+        // Return a media.
+        inline const Media& get_media (size_t index) const
+            { return medias[index]; }
+
+        /* Return the range of medias on screen, from first to last (not
+           included). */
+        void get_visible_range (size_t& first, size_t& last);
+
+        /* Give the focus to a given media.
+           Return true if any media got the focus. */
+        bool set_focus (int index);
+
+    private:
+
+        // The box is shown.
+        void on_show ();
+
+        /* Measure the cells, grow the pool to cover the screen and its
+           margins, and make the layout as big as the whole grid. */
+        void update_size ();
+
+        // Return the range of rows that have entries, given the scroll.
+        void get_bound_rows (size_t& first_row, size_t& last_row);
+
+        /* Move the entries of the medias kept to their new indexes, given
+           by new_indexes (NONE for the medias removed). */
+        void move_entries (const std::vector<size_t>& new_indexes);
+
+        // Return the entry of a media, or null if it has no entry.
+        MediaEntry* get_entry (size_t index);
+
+        // Return the position in the pool of the entry of a media.
+        inline size_t get_slot (size_t index) const
+            { return (index / cols % pool_rows) * cols + index % cols; }
+
+};
+
+#endif
@@ -0,0 +1,116 @@
+/*
+mediashandler.cpp - SAX handler that decodes a list of medias.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "mediashandler.h"
+
+MediasHandler::MediasHandler (const std::string& root, MediasResult& result):
+    root (root), result (result), depth (0), in_list (false), key (),
+    media (), has_code (false), code (0)
+{}
+
+MediasHandler::~MediasHandler ()
+{}
+
+bool MediasHandler::Default ()
+{
+    // Ignore the values we don't know
+    return true;
+}
+
+bool MediasHandler::Int (int i)
+{
+    if (depth == 1 and key == "code") {
+        has_code = true;
+        code = i;
+    } else if (in_media ()) {
+        if (key == "season") {
+            media.set_season (i);
+        } else if (key == "episode") {
+            media.set_episode (i);
+        }
+    }
+    return true;
+}
+
+bool MediasHandler::Uint (unsigned u)
+{
+    return Int (static_cast<int> (u));
+}
+
+bool MediasHandler::String (
+    const char* s, rapidjson::SizeType length, bool copy)
+{
+    if (in_media ()) {
+        if (key == "title_id") {
+            media.set_title_id (s, length);
+        } else if (key == "title") {
+            media.set_title (s, length);
+        } else if (key == "rating") {
+            media.set_rating (s, length);
+        }
+    }
+    return true;
+}
+
+bool MediasHandler::Key (const char* s, rapidjson::SizeType length, bool copy)
+{
+    if (depth == 1 or in_media ()) {
+        key.assign (s, length);
+    }
+    return true;
+}
+
+bool MediasHandler::StartObject ()
+{
+    depth++;
+    if (in_media ()) {
+        media = Media ();
+    }
+    return true;
+}
+
+bool MediasHandler::EndObject (rapidjson::SizeType count)
+{
+    if (in_media ()) {
+        result.add (std::move (media));
+    }
+    depth--;
+    return true;
+}
+
+bool MediasHandler::StartArray ()
+{
+    depth++;
+    if (depth == 2 and key == root) {
+        in_list = true;
+    }
+    return true;
+}
+
+bool MediasHandler::EndArray (rapidjson::SizeType count)
+{
+    if (depth == 2) {
+        in_list = false;
+    }
+    depth--;
+    return true;
+}
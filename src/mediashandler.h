@@ -0,0 +1,93 @@
+/*
+mediashandler.h - SAX handler that decodes a list of medias.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MEDIASHANDLER_H
+#define MEDIASHANDLER_H
+
+#include <rapidjson/reader.h>
+#include <string>
+
+#include "media.h"
+#include "mediasresult.h"
+
+/* Decode the medias from the server's response directly into a MediasResult
+   while the JSON is parsed, without building a document. The response is an
+   object with a "code" member and the list of medias in the member given by
+   root. */
+class MediasHandler:
+    public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, MediasHandler>
+{
+
+    private:
+
+        // Name of the member that contains the list of medias
+        std::string root;
+
+        // Where to put the decoded medias
+        MediasResult& result;
+
+        // Nesting level of the current value (1 is the response object)
+        int depth;
+
+        // True while inside the list of medias
+        bool in_list;
+
+        // The last key found
+        std::string key;
+
+        // The media being decoded
+        Media media;
+
+        // Code returned by the server
+        bool has_code;
+        int code;
+
+    public:
+
+        MediasHandler (const std::string& root, MediasResult& result);
+        ~MediasHandler ();
+
+        // Return true if the response contained a code.
+        inline bool get_has_code () const { return has_code; }
+
+        // Return the code returned by the server.
+        inline int get_code () const { return code; }
+
+        // Implementation of the rapidjson handler concept
+        bool Default ();
+        bool Int (int i);
+        bool Uint (unsigned u);
+        bool String (const char* s, rapidjson::SizeType length, bool copy);
+        bool Key (const char* s, rapidjson::SizeType length, bool copy);
+        bool StartObject ();
+        bool EndObject (rapidjson::SizeType count);
+        bool StartArray ();
+        bool EndArray (rapidjson::SizeType count);
+
+    private:
+
+        // Return true if the current value is a member of a media.
+        inline bool in_media () const { return in_list and depth == 3; }
+
+};
+
+#endif
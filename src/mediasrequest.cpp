@@ -0,0 +1,90 @@
+/*
+mediasrequest.cpp - Request the list of medias of a category.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+
+#include "mediashandler.h"
+#include "mediasrequest.h"
+
+MediasRequest::MediasRequest (const std::string& server_address,
+                              const std::string& profile,
+                              const std::string& category,
+                              MediasListener& listener):
+    Request (server_address), profile (profile), category (category),
+    listener (&listener)
+{}
+
+MediasRequest::MediasRequest (const std::string& server_address,
+                              const std::string& category):
+    Request (server_address), profile (), category (category),
+    listener (nullptr)
+{}
+
+MediasRequest::~MediasRequest ()
+{}
+
+std::string MediasRequest::get_api_function () const
+{
+    return "gettop?profile=" + escape (profile) + "&category="
+        + escape (category);
+}
+
+std::string MediasRequest::get_root () const
+{
+    return "top";
+}
+
+void MediasRequest::run ()
+{
+    auto r = std::make_unique<MediasResult>();
+    r->set_category (category);
+
+    // Don't parse results that nobody will see
+    auto followers = land ();
+    if (is_cancelled () and followers.empty ()) {
+        return;
+    }
+
+    try {
+        // Decode the medias while parsing, the lists can be large
+        MediasHandler handler (get_root (), *r);
+        parse_json_response (handler);
+        r->set_error (false);
+    } catch (std::runtime_error& e) {
+        std::cerr << e.what () << std::endl;
+        r->set_error (true);
+    }
+
+    // Pass a copy of the result to the identical requests
+    for (auto& f: followers) {
+        auto copy = std::make_unique<MediasResult> (*r);
+        static_cast<MediasRequest&>(*f).notify (copy);
+    }
+    if (not is_cancelled ()) {
+        notify (r);
+    }
+}
+
+void MediasRequest::notify (std::unique_ptr<MediasResult>& result)
+{
+    listener->medias_received (result);
+}
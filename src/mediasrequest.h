@@ -0,0 +1,77 @@
+/*
+mediasrequest.h - Request the list of medias of a category.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MEDIASREQUEST_H
+#define MEDIASREQUEST_H
+
+#include <memory>
+#include <string>
+
+#include "mediaslistener.h"
+#include "mediasresult.h"
+#include "request.h"
+
+class MediasRequest: public Request {
+
+    private:
+
+        // Profile that asks for the medias.
+        std::string profile;
+
+        // Category of the medias.
+        std::string category;
+
+        // Listener to receive the event of medias received.
+        MediasListener* listener;
+
+    public:
+
+        MediasRequest (const std::string& server_address,
+                       const std::string& profile,
+                       const std::string& category,
+                       MediasListener& listener);
+        ~MediasRequest ();
+
+        // Run this request.
+        void run ();
+
+        // Return the category of the medias.
+        inline const std::string& get_category () const { return category; }
+
+    protected:
+
+        // Constructor for the subclasses, that use other listeners.
+        MediasRequest (const std::string& server_address,
+                       const std::string& category);
+
+        // Return the API function to call.
+        std::string get_api_function () const;
+
+        // Return the name of the JSON member with the list of medias.
+        virtual std::string get_root () const;
+
+        // Pass the result to the listener.
+        virtual void notify (std::unique_ptr<MediasResult>& result);
+
+};
+
+#endif
@@ -0,0 +1,66 @@
+/*
+mediasresult.h - The result from a medias request.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MEDIASRESULT_H
+#define MEDIASRESULT_H
+
+#include <string>
+#include <vector>
+
+#include "media.h"
+#include "requestresult.h"
+
+class MediasResult: public RequestResult {
+
+    private:
+
+        // Category of the medias
+        std::string category;
+
+        // List of medias
+        std::vector<Media> medias;
+
+    public:
+
+        MediasResult ();
+        ~MediasResult ();
+
+        // Set the category of the medias.
+        inline void set_category (const std::string& category)
+            { this->category = category; }
+
+        // Return the category of the medias.
+        inline const std::string& get_category () const { return category; }
+
+        // Add a media.
+        inline void add (Media&& media)
+            { medias.push_back (std::move (media)); }
+
+        // Return the list of medias.
+        inline std::vector<Media>& get_medias () { return medias; }
+
+        // Return the number of medias.
+        inline int size () const { return medias.size (); }
+
+};
+
+#endif
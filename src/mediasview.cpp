@@ -135,165 +135,6 @@ medias_view_set_profile_picture (PictureRequest *r)
     g_idle_add ((GSourceFunc)medias_view_update_profile_picture, r);
 }
 
-static gboolean
-medias_view_update_poster (PictureRequest *r)
-{
-    GdkPixbuf *p = NULL;
-    GInputStream *gis;
-
-    if (r->error) {
-        p = gdk_pixbuf_new_from_file_at_scale (paths_get_default_picture(),
-            medias_view.medias_box.poster_w, medias_view.medias_box.poster_h,
-            FALSE, NULL);
-    } else {
-        if (r->picture->len > 0) {
-            gis = g_memory_input_stream_new_from_data (
-                r->picture->data, r->picture->len, NULL);
-            p = gdk_pixbuf_new_from_stream_at_scale (gis,
-                medias_view.medias_box.poster_w,
-                medias_view.medias_box.poster_h, FALSE, NULL, NULL);
-            if (!p) {
-                warnx ("medias_view_update_poster: cannot load poster for "
-                    "title '%s'", ((Media *)r->data)->title_id);
-                p = gdk_pixbuf_new_from_file_at_scale (
-                    paths_get_default_picture(),
-                    medias_view.medias_box.poster_w,
-                    medias_view.medias_box.poster_h, FALSE, NULL);
-            }
-            g_object_unref (gis);
-        } else {
-            p = gdk_pixbuf_new_from_file_at_scale (paths_get_default_picture(),
-                medias_view.medias_box.poster_w,
-                medias_view.medias_box.poster_h, FALSE, NULL);
-        }
-    }
-    mediasbox_set_poster (&medias_view.medias_box, (Media *)r->data, p);
-    request_picture_destroy (r);
-    return FALSE;
-}
-
-static void
-medias_view_set_poster_box (PictureRequest *r)
-{
-    g_idle_add ((GSourceFunc)medias_view_update_poster, r);
-}
-
-static void
-medias_view_set_medias_list (GPtrArray *medias)
-{
-    Media *m;
-
-    if (medias->len) {
-        if (mediasbox_set_medias (
-            &medias_view.medias_box, medias))
-        {
-            GHashTable *h = g_hash_table_new (g_str_hash, g_str_equal);
-            for (int i = 0; i < medias->len; i++) {
-                // Keep a set with the requested poster and don't do
-                // repeated requests
-                m = (Media *)g_ptr_array_index (medias, i);
-                if (g_hash_table_add (h, m->title_id)) {
-                    core_request_poster (
-                        m, medias_view_set_poster_box);
-                }
-            }
-            g_hash_table_unref (h);
-        }
-        gtk_widget_show_all (medias_view.medias_box.box);
-        gtk_stack_set_visible_child_name (
-            GTK_STACK (medias_view.stack), "medias");
-        mediasbox_select (&medias_view.medias_box, 0);
-    } else {
-        // Show a mesage that no medias are available
-        gtk_label_set_text (
-            GTK_LABEL (medias_view.label), "No medias available");
-        gtk_widget_show (medias_view.label);
-        gtk_stack_set_visible_child (
-            GTK_STACK (medias_view.stack), medias_view.label);
-    }
-}
-
-static gboolean
-medias_view_update_medias (MediasRequest *r)
-{
-    // Check that the current category is the one we asked for
-    if (strcmp (r->category, gtk_button_get_label (
-        GTK_BUTTON (medias_view.current_category))) == 0)
-    {
-        if (r->error) {
-            gtk_label_set_text (
-                GTK_LABEL (medias_view.label), "No medias available");
-            gtk_widget_show (medias_view.label);
-            gtk_stack_set_visible_child (
-                GTK_STACK (medias_view.stack), medias_view.label);
-        } else {
-            medias_view_set_medias_list (r->medias);
-        }
-    }
-    request_medias_destroy (r);
-    return FALSE;
-}
-
-static void
-medias_view_set_medias (MediasRequest *r)
-{
-    g_idle_add ((GSourceFunc)medias_view_update_medias, r);
-}
-
-static void
-medias_view_category_clicked (GtkWidget *widget, gpointer user_data)
-{
-    GtkStyleContext *context;
-
-    // Update the current category button
-    if (medias_view.current_category) {
-        context = gtk_widget_get_style_context (medias_view.current_category);
-        gtk_style_context_remove_class(context, "current-category");
-    }
-    medias_view.current_category = widget;
-    context = gtk_widget_get_style_context (widget);
-    gtk_style_context_add_class(context, "current-category");
-    // Retrieve the list of medias
-    if (gtk_widget_is_visible (medias_view.box)) {
-        core_request_medias (
-            gtk_button_get_label (GTK_BUTTON(widget)), medias_view_set_medias);
-    }
-}
-
-static void
-medias_view_update_categories (CategoriesRequest *r)
-{
-    if (!r->error) {
-        size_t size = request_categories_size (r);
-        medias_view.category_buttons = g_ptr_array_sized_new (size);
-        for (int i = 0; i < size; i++) {
-            GtkWidget *b = xbutton (
-                (const char *)request_categories_get (r, i),
-                medias_view_category_clicked, NULL, "bar-element",
-                "bar-button", "bar-button-raw", NULL);
-            g_ptr_array_add (medias_view.category_buttons, b);
-            gtk_widget_show (b);
-            menubar_add_front (&medias_view.bar, b);
-        }
-        if (size) {
-            medias_view_category_clicked (
-                (GtkWidget *)g_ptr_array_index (
-                    medias_view.category_buttons, 0), NULL);
-        }
-    } else {
-        g_timeout_add_seconds (QUERY_CATEGORIES_TIMEOUT,
-            (GSourceFunc)core_request_categories,
-            (gpointer)medias_view_set_categories);
-    }
-    request_categories_destroy (r);
-}
-
-static void
-medias_view_set_categories (CategoriesRequest *r)
-{
-    g_idle_add ((GSourceFunc)medias_view_update_categories, r);
-}
-
 static void
 medias_view_show (GtkWidget *widget, GdkEvent *event, gpointer user_data)
 {
@@ -410,15 +251,245 @@ medias_view_destroyed (GtkWidget *widget, gpointer user_data)
     }
 }*/
 
+#include <algorithm>
+#include <glibmm/main.h>
+
 #include "mediasview.h"
 
-MediasView::MediasView (ViewControllerInterface& controller):
-    View (controller)
-{}
+MediasView::MediasView (ViewControllerInterface& controller,
+                        int prefetch_rows):
+    BarView (controller),
+    stack (),
+    label ("No medias available"),
+    medias_box (MEDIAS_BOX_NUM_COLS, prefetch_rows),
+    category_buttons (),
+    current_category (nullptr),
+    medias_token (),
+    posters_token (),
+    poster_priorities ()
+{
+    // Complete the label
+    label.get_style_context ()->add_class ("view-label");
+
+    // Add a stack to alternate between a message and the list of medias
+    get_box ().pack_start (stack, true, true);
+    stack.add (label, "label");
+    stack.add (medias_box.get_box (), "medias");
+
+    // Load the posters as they get close to the screen
+    auto adjustment = medias_box.get_box ().get_vadjustment ();
+    adjustment->signal_value_changed ().connect (
+        sigc::mem_fun (*this, &MediasView::load_posters));
+    adjustment->signal_changed ().connect (
+        sigc::mem_fun (*this, &MediasView::load_posters));
+
+    // Show all elements
+    get_box ().show_all ();
+}
 
 MediasView::~MediasView ()
 {}
 
+void MediasView::show ()
+{
+    // Compute the medias box's poster size
+    int w = get_controller ().get_window ().get_width () / MEDIAS_BOX_NUM_COLS
+        - 2*POSTER_BORDER;
+    int h = w * POSTER_RATIO_H / POSTER_RATIO_W;
+    medias_box.set_poster_size (w, h);
+
+    if (current_category) {
+        on_category_clicked (current_category);
+    } else if (category_buttons.empty ()) {
+        get_controller ().get_core ().request_categories (*this);
+    }
+}
+
 void MediasView::set_data (const ViewSwitchData& data)
 {}
 
+void MediasView::categories_received (
+    std::unique_ptr<CategoriesResult>& result)
+{
+    std::shared_ptr<CategoriesResult> r (std::move (result));
+    get_controller ().get_main_queue ().push (
+        sigc::bind (sigc::mem_fun (*this, &MediasView::on_categories_received),
+            r));
+}
+
+void MediasView::on_categories_received (
+    const std::shared_ptr<CategoriesResult>& result)
+{
+    if (result->get_error ()) {
+        // Request again the list of categories after a given timeout
+        Glib::signal_timeout ().connect_seconds (
+            sigc::mem_fun (*this, &MediasView::on_timeout),
+            QUERY_CATEGORIES_TIMEOUT);
+        return;
+    }
+    for (auto& c: result->get_categories ()) {
+        auto b = std::make_unique<Gtk::Button> (c);
+        auto context = b->get_style_context ();
+        context->add_class ("bar-element");
+        context->add_class ("bar-button");
+        context->add_class ("bar-button-raw");
+        b->signal_clicked ().connect (sigc::bind (
+            sigc::mem_fun (*this, &MediasView::on_category_clicked), b.get ()));
+        b->show ();
+        get_bar ().add_front (*b);
+        category_buttons.push_back (std::move (b));
+    }
+    if (not category_buttons.empty ()) {
+        on_category_clicked (category_buttons[0].get ());
+        category_buttons[0]->grab_focus ();
+    }
+}
+
+bool MediasView::on_timeout ()
+{
+    get_controller ().get_core ().request_categories (*this);
+    return false;
+}
+
+void MediasView::on_category_clicked (Gtk::Button* button)
+{
+    // Update the current category button
+    if (current_category) {
+        current_category->get_style_context ()->remove_class (
+            "current-category");
+    }
+    current_category = button;
+    button->get_style_context ()->add_class ("current-category");
+
+    // Retrieve the list of medias, superseding the previous request
+    if (get_controller ().get_current_view () == &get_box ()) {
+        if (medias_token) {
+            medias_token->cancel ();
+        }
+        medias_token = std::make_shared<CancelToken> ();
+        get_controller ().get_core ().request_medias (
+            button->get_label (), *this, medias_token);
+    }
+}
+
+void MediasView::medias_received (std::unique_ptr<MediasResult>& result)
+{
+    std::shared_ptr<MediasResult> r (std::move (result));
+    get_controller ().get_main_queue ().push (
+        sigc::bind (sigc::mem_fun (*this, &MediasView::on_medias_received),
+            r));
+}
+
+void MediasView::on_medias_received (
+    const std::shared_ptr<MediasResult>& result)
+{
+    // Check that the current category is the one we asked for
+    if (not current_category
+        or result->get_category () != current_category->get_label ())
+    {
+        return;
+    }
+    if (result->get_error () or not result->size ()) {
+        show_label ("No medias available");
+    } else {
+        set_medias (result->get_medias ());
+    }
+}
+
+void MediasView::set_medias (const std::vector<Media>& medias)
+{
+    auto result = medias_box.set (medias);
+    if (result == MediasBox::REPLACED) {
+        // The posters of the previous list won't be shown
+        if (posters_token) {
+            posters_token->cancel ();
+        }
+        posters_token = std::make_shared<CancelToken> ();
+        poster_priorities.clear ();
+    }
+    load_posters ();
+    stack.set_visible_child ("medias");
+
+    // A refresh of the list keeps the focus where the user left it
+    if (result == MediasBox::REPLACED) {
+        medias_box.set_focus (0);
+    }
+}
+
+void MediasView::load_posters ()
+{
+    /* Request the posters of the entries bound to other medias, once for
+       each title and ranked before they are sent. The posters received
+       before come from the cache of the core. */
+    std::vector<size_t> bound;
+    std::vector<std::string> titles;
+    medias_box.bind_visible (bound);
+    for (auto i: bound) {
+        auto& title_id = medias_box.get_media (i).get_title_id ();
+        auto& priority = poster_priorities[title_id];
+        if (not priority) {
+            priority = std::make_shared<RequestPriority> (
+                RequestPriority::PREFETCH);
+            titles.push_back (title_id);
+        }
+    }
+    update_priorities ();
+    for (auto& t: titles) {
+        get_controller ().get_core ().request_poster (
+            t, medias_box.get_poster_width (),
+            medias_box.get_poster_height (), *this, posters_token,
+            poster_priorities[t]);
+    }
+}
+
+void MediasView::poster_received (std::unique_ptr<PictureResult>& result)
+{
+    // The poster is already decoded at the size of the entries
+    std::shared_ptr<PictureResult> r (std::move (result));
+    get_controller ().get_main_queue ().push ([this, r] () {
+        poster_priorities.erase (r->get_id ());
+        if (r->get_pixbuf ()) {
+            medias_box.set_poster (r->get_id (), r->get_pixbuf ());
+        }
+    });
+}
+
+void MediasView::update_priorities ()
+{
+    if (poster_priorities.empty ()) {
+        return;
+    }
+
+    // The posters within a page from the screen come next, then the rest
+    size_t first, last;
+    medias_box.get_visible_range (first, last);
+    size_t page = last - first;
+    size_t near_first = first > page ? first - page : 0;
+    size_t near_last = std::min (last + page, medias_box.size ());
+
+    // A title repeated in the grid keeps its most urgent class
+    std::unordered_map<std::string, RequestPriority::Class> ranks;
+    for (auto i = near_first; i < near_last; i++) {
+        auto priority = RequestPriority::OFFSCREEN;
+        if (first <= i and i < last) {
+            priority = RequestPriority::VISIBLE;
+        }
+        auto& title_id = medias_box.get_media (i).get_title_id ();
+        auto it = ranks.find (title_id);
+        if (it == ranks.end () or priority < it->second) {
+            ranks[title_id] = priority;
+        }
+    }
+    for (auto& p: poster_priorities) {
+        auto it = ranks.find (p.first);
+        p.second->set (
+            it != ranks.end () ? it->second : RequestPriority::PREFETCH);
+    }
+}
+
+void MediasView::show_label (const std::string& text)
+{
+    label.set_text (text);
+    stack.set_visible_child (label);
+}
+
@@ -23,9 +23,20 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #ifndef MEDIASVIEW_H
 #define MEDIASVIEW_H
 
+#include <gtkmm/button.h>
+#include <gtkmm/label.h>
+#include <gtkmm/stack.h>
 #include <gtkmm/window.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
-#include "view.h"
+#include "barview.h"
+#include "categorieslistener.h"
+#include "mediasbox.h"
+#include "mediaslistener.h"
+#include "posterlistener.h"
+#include "requestpriority.h"
 
 /*typedef struct MediasView_s {
     GtkWidget *box;
@@ -44,16 +55,94 @@ extern MediasView_t medias_view;
 int
 medias_view_create ();*/
 
-class MediasView: public View {
+class MediasView: public BarView, CategoriesListener, MediasListener,
+                         PosterListener
+{
+
+    private:
+
+        // Constants
+        static const int QUERY_CATEGORIES_TIMEOUT = 1;
+        static const int MEDIAS_BOX_NUM_COLS = 5;
+        static const int POSTER_BORDER = 4;
+        static const int POSTER_RATIO_W = 182;
+        static const int POSTER_RATIO_H = 268;
+
+        // Stack to switch between the label and the medias box
+        Gtk::Stack stack;
+
+        // Label to show a message of no medias available
+        Gtk::Label label;
+
+        // Grid of medias
+        MediasBox medias_box;
+
+        // Buttons to choose the category
+        std::vector<std::unique_ptr<Gtk::Button> > category_buttons;
+
+        // Button of the category shown
+        Gtk::Button* current_category;
+
+        // Tokens to cancel the list of medias and the posters requested
+        std::shared_ptr<CancelToken> medias_token;
+        std::shared_ptr<CancelToken> posters_token;
+
+        // Priorities of the posters not received yet, by title id
+        std::unordered_map<std::string, std::shared_ptr<RequestPriority> >
+            poster_priorities;
 
     public:
 
-        MediasView (ViewControllerInterface& controller);
+        // Default number of rows loaded beyond the screen
+        static const int DEFAULT_PREFETCH_ROWS = 2;
+
+        MediasView (ViewControllerInterface& controller, int prefetch_rows);
         ~MediasView ();
 
+        // Show this view
+        void show ();
+
         // Pass some data to this view.
         void set_data (const ViewSwitchData& data);
 
+        // Implementation of the CategoriesListener interface.
+        void categories_received (std::unique_ptr<CategoriesResult>& result);
+
+        // Implementation of the MediasListener interface.
+        void medias_received (std::unique_ptr<MediasResult>& result);
+
+        // Implementation of the PosterListener interface.
+        void poster_received (std::unique_ptr<PictureResult>& result);
+
+    private:
+
+        // Executed when the list of categories is received
+        void on_categories_received (
+            const std::shared_ptr<CategoriesResult>& result);
+
+        // Executed when the list of medias is received
+        void on_medias_received (const std::shared_ptr<MediasResult>& result);
+
+        // Executed when a category button is clicked
+        void on_category_clicked (Gtk::Button* button);
+
+        // Executed when the timeout to query the categories is expired
+        bool on_timeout ();
+
+        // Show the list of medias and request their posters
+        void set_medias (const std::vector<Media>& medias);
+
+        /* Create the entries near the screen and request the posters not
+           requested yet. Executed when the medias box is scrolled or
+           resized. */
+        void load_posters ();
+
+        // Rank the posters not received yet by their distance to the screen
+        void update_priorities ();
+
+        // Put a text in the info label
+        void show_label (const std::string& text);
+
 };
 
 #endif
@@ -0,0 +1,44 @@
+/*
+memorysink.cpp - Receive the body of a response in memory.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "memorysink.h"
+
+MemorySink::MemorySink ():
+    buffer ()
+{}
+
+MemorySink::~MemorySink ()
+{}
+
+void MemorySink::set_length (size_t length)
+{
+    // The length comes from the server, it is only a hint
+    buffer.reserve (std::min (length, MAX_RESERVED));
+}
+
+bool MemorySink::write (const char* bytes, size_t length)
+{
+    buffer.append (bytes, length);
+    return true;
+}
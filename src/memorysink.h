@@ -0,0 +1,59 @@
+/*
+memorysink.h - Receive the body of a response in memory.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MEMORYSINK_H
+#define MEMORYSINK_H
+
+#include "bodysink.h"
+#include "responsebuffer.h"
+
+class MemorySink: public BodySink {
+
+    private:
+
+        // Most memory reserved in advance for a body, whatever its announced
+        // length; a longer body grows the buffer as it arrives
+        static constexpr size_t MAX_RESERVED = 16 * 1024 * 1024;
+
+        // The buffer with the body
+        ResponseBuffer buffer;
+
+    public:
+
+        MemorySink ();
+        ~MemorySink ();
+
+        // Return the buffer with the body.
+        inline ResponseBuffer& get_buffer () { return buffer; }
+
+        // Empty the buffer, to receive a new body.
+        inline void clear () { buffer.clear (); }
+
+        // Implementation of the BodySink interface.
+        void set_length (size_t length);
+
+        // Implementation of the BodySink interface.
+        bool write (const char* bytes, size_t length);
+
+};
+
+#endif
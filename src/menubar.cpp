@@ -2,12 +2,11 @@
 #include "menubar.h"
 #include "paths.h"
 
-MenuBar::MenuBar (int height):
+MenuBar::MenuBar (IconAtlas& icons, int height):
     box (Gtk::ORIENTATION_HORIZONTAL), logo (), height (height)
 {
     // Create the pixbuf with the logo image
-    auto pixbuf = Gdk::Pixbuf::create_from_file (
-        Paths::get_logo (), -1, height - LOGO_MARGIN * 2, true);
+    auto pixbuf = icons.get (Paths::get_logo (), -1, height - LOGO_MARGIN * 2);
 
     // Create the image from the pixbuf
     logo.set (pixbuf);
@@ -31,6 +30,11 @@ int MenuBar::get_height () const
     return height;
 }
 
+void MenuBar::add_front (Gtk::Widget &widget)
+{
+    box.pack_start (widget, false, false);
+}
+
 void MenuBar::add_back (Gtk::Widget &widget)
 {
     box.pack_end (widget, false, false);
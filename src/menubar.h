@@ -26,6 +26,8 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #include <gtkmm/box.h>
 #include <gtkmm/image.h>
 
+#include "iconatlas.h"
+
 class MenuBar {
 
     private:
@@ -38,7 +40,7 @@ class MenuBar {
 
     public:
 
-        MenuBar (int height);
+        MenuBar (IconAtlas& icons, int height);
         ~MenuBar ();
 
         // Return the container box of this menu bar.
@@ -47,6 +49,9 @@ class MenuBar {
         // Return the height of this bar.
         int get_height () const;
 
+        // Add a component to the front of this menu bar, after the logo.
+        void add_front (Gtk::Widget &widget);
+
         // Add a component to the back of this menu bar.
         void add_back (Gtk::Widget &widget);
 
@@ -20,21 +20,17 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 <http://www.gnu.org/licenses/>.
 */
 
-#include "paths.h"
-
-/*#define DEFAULT_PICTURE_FILE    "profile-default.svg"
+#include <glibmm/miscutils.h>
 
-static const char *default_picture_path = STATIC_PATH "/" DEFAULT_PICTURE_FILE;
-
-const char *
-paths_get_default_picture ()
-{
-    return default_picture_path;
-}*/
+#include "paths.h"
 
 const std::filesystem::path Paths::static_path ("data");
+const std::filesystem::path Paths::default_picture_file (
+    "profile-default.svg");
 const std::filesystem::path Paths::logo_file ("tvfamily.svg");
 const std::filesystem::path Paths::styles_file ("styles.css");
+const std::filesystem::path Paths::default_picture_path (
+    static_path / default_picture_file);
 const std::filesystem::path Paths::logo_path (static_path / logo_file);
 const std::filesystem::path Paths::styles_path (static_path / styles_file);
 
@@ -43,6 +39,21 @@ std::filesystem::path Paths::get_image (const std::string& image)
     return static_path / (image + ".svg");
 }
 
+std::filesystem::path Paths::get_cache ()
+{
+    return std::filesystem::path (Glib::get_user_cache_dir ()) / "tvfamily-gtk";
+}
+
+std::filesystem::path Paths::get_icon_cache ()
+{
+    return get_cache () / "icons";
+}
+
+const std::filesystem::path& Paths::get_default_picture ()
+{
+    return default_picture_path;
+}
+
 const std::filesystem::path& Paths::get_logo ()
 {
     return logo_path;
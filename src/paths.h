@@ -24,16 +24,15 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #define PATHS_H
 
 #include <filesystem>
-
-/*
-const char *
-paths_get_default_picture ();*/
+#include <string>
 
 class Paths {
 
     private:
 
         static const std::filesystem::path static_path;
+        static const std::filesystem::path default_picture_file;
+        static const std::filesystem::path default_picture_path;
         static const std::filesystem::path logo_file;
         static const std::filesystem::path logo_path;
         static const std::filesystem::path styles_file;
@@ -44,6 +43,15 @@ class Paths {
         // Return an image file.
         static std::filesystem::path get_image (const std::string& image);
 
+        // Return the directory to cache the downloaded files.
+        static std::filesystem::path get_cache ();
+
+        // Return the directory to cache the rendered icons.
+        static std::filesystem::path get_icon_cache ();
+
+        // Return the path to the picture used when there is none.
+        static const std::filesystem::path& get_default_picture ();
+
         // Return the path to the logo image file.
         static const std::filesystem::path& get_logo ();
 
@@ -0,0 +1,172 @@
+/*
+picturerequest.cpp - Base class of the requests that download a picture.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <fstream>
+#include <iostream>
+
+#include "paths.h"
+#include "picturerequest.h"
+
+PictureRequest::PictureRequest (const std::string& server_address,
+                                const std::string& id,
+                                const std::string& api_function,
+                                int width,
+                                int height,
+                                bool preserve_aspect,
+                                ImageCache& cache,
+                                PixbufCache& pixbuf_cache):
+    Request (server_address), id (id), api_function (api_function),
+    key (get_cache_key (server_address, api_function)), width (width),
+    height (height), preserve_aspect (preserve_aspect), cache (cache),
+    pixbuf_cache (pixbuf_cache), cached (), has_cached (false),
+    pixbuf_sink (), temp_path (cache.get_temp_path (key)),
+    file_sink (temp_path),
+    tee_sink (pixbuf_sink, temp_path.empty () ? nullptr : &file_sink)
+{
+    // Revalidate the cached copy, if any
+    has_cached = cache.lookup (key, cached);
+    if (has_cached) {
+        set_validators (cached.etag, cached.last_modified);
+    }
+    pixbuf_sink.set_size (width, height, preserve_aspect);
+    set_sink (tee_sink);
+}
+
+PictureRequest::~PictureRequest ()
+{}
+
+std::string PictureRequest::get_api_function () const
+{
+    return api_function;
+}
+
+std::string PictureRequest::get_key () const
+{
+    // Requests of the same picture at other sizes decode it differently
+    return Request::get_key () + "@" + std::to_string (width) + "x"
+        + std::to_string (height);
+}
+
+std::string PictureRequest::get_cache_key (const std::string& server_address,
+                                           const std::string& api_function)
+{
+    return server_address + "/api/" + api_function;
+}
+
+RequestPriority::Class PictureRequest::get_default_priority () const
+{
+    return RequestPriority::VISIBLE;
+}
+
+void PictureRequest::run ()
+{
+    auto r = std::make_unique<PictureResult> (id);
+    auto stored = false;
+
+    // Don't decode pictures that nobody will see
+    auto followers = land ();
+    if (is_cancelled () and followers.empty ()) {
+        // Only the copy is closed, to remove its file
+        pixbuf_sink.discard ();
+        tee_sink.close ();
+        if (not temp_path.empty ()) {
+            cache.discard (temp_path);
+        }
+        return;
+    }
+
+    // Decode the picture, the transfers thread only kept its bytes
+    tee_sink.close ();
+    try {
+        check_transfer ();
+        if (not is_not_modified ()) {
+            r->set_pixbuf (pixbuf_sink.get_pixbuf ());
+            if (not r->get_pixbuf ()) {
+                std::cerr << "cannot decode picture " << id << std::endl;
+            } else {
+                stored = store ();
+            }
+        }
+    } catch (std::runtime_error& e) {
+        std::cerr << e.what () << std::endl;
+        r->set_error (true);
+    }
+    if (not stored and not temp_path.empty ()) {
+        cache.discard (temp_path);
+    }
+
+    // Not modified, or not available: use the cached copy
+    if (not r->get_pixbuf () and has_cached) {
+        r->set_pixbuf (load (cached.path));
+        if (not r->get_pixbuf ()) {
+            cache.remove (key);
+        }
+    }
+
+    if (r->get_pixbuf ()) {
+        pixbuf_cache.add (api_function, width, height, r->get_pixbuf ());
+    } else {
+        // Use the default picture, loaded here to keep it off the main loop
+        r->set_pixbuf (load (Paths::get_default_picture ()));
+    }
+
+    // Pass a copy of the result to the identical requests
+    for (auto& f: followers) {
+        auto copy = std::make_unique<PictureResult> (*r);
+        static_cast<PictureRequest&>(*f).notify (copy);
+    }
+    if (not is_cancelled ()) {
+        notify (r);
+    }
+}
+
+bool PictureRequest::store ()
+{
+    // Without validators the picture would be downloaded again anyway
+    if (not tee_sink.is_copy_complete () or file_sink.get_error ()
+        or (get_etag ().empty () and get_last_modified ().empty ()))
+    {
+        return false;
+    }
+    cache.store (key, temp_path, get_etag (), get_last_modified ());
+    return true;
+}
+
+Glib::RefPtr<Gdk::Pixbuf> PictureRequest::load (
+    const std::filesystem::path& path)
+{
+    // Decode it as a response, to resize it the same way
+    PixbufSink sink;
+    sink.set_size (width, height, preserve_aspect);
+    std::ifstream file (path, std::ios::binary);
+    char buffer[LOAD_BUFFER_SIZE];
+    while (file.read (buffer, sizeof (buffer)) or file.gcount ()) {
+        if (not sink.write (buffer, file.gcount ())) {
+            break;
+        }
+    }
+    sink.close ();
+    if (not sink.get_pixbuf ()) {
+        std::cerr << "cannot load picture " << path << std::endl;
+    }
+    return sink.get_pixbuf ();
+}
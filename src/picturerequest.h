@@ -0,0 +1,135 @@
+/*
+picturerequest.h - Base class of the requests that download a picture.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PICTUREREQUEST_H
+#define PICTUREREQUEST_H
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "filesink.h"
+#include "imagecache.h"
+#include "pictureresult.h"
+#include "pixbufcache.h"
+#include "pixbufsink.h"
+#include "request.h"
+#include "teesink.h"
+
+/* Download a picture and decode it at its final size in the worker, so
+   that only the scaled image reaches the main thread.
+
+   The picture is kept in the image cache, keyed by its URL. When it is
+   cached, the request asks the server to send it only if it has changed,
+   and the cached file is used when it hasn't or the server is down. The
+   decoded picture is kept in the memory cache, keyed by the API function
+   and the size. */
+class PictureRequest: public Request {
+
+    private:
+
+        // Size of the chunks read from a cached picture
+        static const size_t LOAD_BUFFER_SIZE = 16384;
+
+        // Identifier of the picture (profile name or title id)
+        std::string id;
+
+        // API function to call, with its arguments
+        std::string api_function;
+
+        // Key of the picture in the cache
+        std::string key;
+
+        // Size of the decoded picture
+        int width;
+        int height;
+
+        // True to fit the picture keeping its aspect ratio
+        bool preserve_aspect;
+
+        // Cache of the pictures on disk
+        ImageCache& cache;
+
+        // Cache of the decoded pictures
+        PixbufCache& pixbuf_cache;
+
+        // Cached copy of the picture, if has_cached is true
+        ImageCache::Entry cached;
+        bool has_cached;
+
+        // Incremental decoder of the response
+        PixbufSink pixbuf_sink;
+
+        // Temporary file to store the response in the cache
+        std::filesystem::path temp_path;
+        FileSink file_sink;
+
+        // Sink that passes the response to the decoder and the file
+        TeeSink tee_sink;
+
+    public:
+
+        PictureRequest (const std::string& server_address,
+                        const std::string& id,
+                        const std::string& api_function,
+                        int width,
+                        int height,
+                        bool preserve_aspect,
+                        ImageCache& cache,
+                        PixbufCache& pixbuf_cache);
+        virtual ~PictureRequest ();
+
+        // Run this request.
+        void run ();
+
+        // Return the key of this request, that includes the size.
+        std::string get_key () const;
+
+        // Return the key of the picture of an API function in the image cache.
+        static std::string get_cache_key (const std::string& server_address,
+                                          const std::string& api_function);
+
+    protected:
+
+        // Return the identifier of the picture.
+        inline const std::string& get_id () const { return id; }
+
+        // Return the API function to call.
+        std::string get_api_function () const;
+
+        // Pictures are visible unless the view tells otherwise.
+        RequestPriority::Class get_default_priority () const;
+
+        // Pass the result to the listener.
+        virtual void notify (std::unique_ptr<PictureResult>& result) = 0;
+
+    private:
+
+        // Move the received picture into the cache. Return true if stored.
+        bool store ();
+
+        // Load a picture file at the requested size, or return null.
+        Glib::RefPtr<Gdk::Pixbuf> load (const std::filesystem::path& path);
+
+};
+
+#endif
@@ -0,0 +1,58 @@
+/*
+pictureresult.h - The result of a picture request.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PICTURERESULT_H
+#define PICTURERESULT_H
+
+#include <gdkmm/pixbuf.h>
+#include <string>
+
+#include "requestresult.h"
+
+class PictureResult: public RequestResult {
+
+    private:
+
+        // Identifier of the picture (profile name or title id)
+        std::string id;
+
+        // The picture, already decoded at the requested size
+        Glib::RefPtr<Gdk::Pixbuf> pixbuf;
+
+    public:
+
+        PictureResult (const std::string& id);
+        ~PictureResult ();
+
+        // Return the identifier of the picture.
+        inline const std::string& get_id () const { return id; }
+
+        // Set the picture.
+        inline void set_pixbuf (const Glib::RefPtr<Gdk::Pixbuf>& pixbuf)
+            { this->pixbuf = pixbuf; }
+
+        // Return the picture.
+        inline Glib::RefPtr<Gdk::Pixbuf>& get_pixbuf () { return pixbuf; }
+
+};
+
+#endif
@@ -0,0 +1,83 @@
+/*
+pixbufcache.cpp - Cache of decoded pictures in memory.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "pixbufcache.h"
+
+PixbufCache::PixbufCache (size_t budget):
+    budget (budget), bytes (0), items (), lru (), mutex ()
+{}
+
+PixbufCache::~PixbufCache ()
+{}
+
+std::string PixbufCache::get_key (
+    const std::string& source, int width, int height)
+{
+    return source + "@" + std::to_string (width) + "x"
+        + std::to_string (height);
+}
+
+Glib::RefPtr<Gdk::Pixbuf> PixbufCache::lookup (
+    const std::string& source, int width, int height)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    auto it = items.find (get_key (source, width, height));
+    if (it == items.end ()) {
+        return Glib::RefPtr<Gdk::Pixbuf> ();
+    }
+    lru.splice (lru.begin (), lru, it->second.lru);
+    return it->second.pixbuf;
+}
+
+void PixbufCache::add (const std::string& source,
+                       int width,
+                       int height,
+                       const Glib::RefPtr<Gdk::Pixbuf>& pixbuf)
+{
+    auto key = get_key (source, width, height);
+    size_t size = pixbuf->get_rowstride () * pixbuf->get_height ();
+    std::lock_guard<std::mutex> lock (mutex);
+
+    // Replace the picture if it is already cached
+    auto it = items.find (key);
+    if (it != items.end ()) {
+        bytes -= it->second.bytes;
+        lru.erase (it->second.lru);
+        items.erase (it);
+    }
+    if (size > budget) {
+        return;
+    }
+    auto& item = items[key];
+    item.pixbuf = pixbuf;
+    item.lru = lru.insert (lru.begin (), key);
+    item.bytes = size;
+    bytes += size;
+
+    // Drop the least recently used pictures that don't fit
+    while (bytes > budget) {
+        auto last = items.find (lru.back ());
+        bytes -= last->second.bytes;
+        items.erase (last);
+        lru.pop_back ();
+    }
+}
@@ -0,0 +1,93 @@
+/*
+pixbufcache.h - Cache of decoded pictures in memory.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PIXBUFCACHE_H
+#define PIXBUFCACHE_H
+
+#include <cstddef>
+#include <gdkmm/pixbuf.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/* Keep the pictures already decoded and scaled, keyed by their source and
+   their size, so that showing them again doesn't decode them again. When
+   the pixels take more than the given budget, the least recently used
+   pictures are dropped. All the methods are thread safe. */
+class PixbufCache {
+
+    private:
+
+        // A cached picture
+        struct Item {
+
+            // The picture
+            Glib::RefPtr<Gdk::Pixbuf> pixbuf;
+
+            // Position in the LRU list
+            std::list<std::string>::iterator lru;
+
+            // Size of the pixels, in bytes
+            size_t bytes;
+        };
+
+        // Maximum size of the pixels, in bytes
+        size_t budget;
+
+        // Current size of the pixels, in bytes
+        size_t bytes;
+
+        // Cached pictures
+        std::unordered_map<std::string, Item> items;
+
+        // Keys, from the most to the least recently used
+        std::list<std::string> lru;
+
+        // Mutex to protect all of the above
+        std::mutex mutex;
+
+    public:
+
+        PixbufCache (size_t budget);
+        ~PixbufCache ();
+
+        /* Return the picture of a source at the given size, or null if it
+           isn't cached. */
+        Glib::RefPtr<Gdk::Pixbuf> lookup (
+            const std::string& source, int width, int height);
+
+        // Add a picture of a source at the given size.
+        void add (const std::string& source,
+                  int width,
+                  int height,
+                  const Glib::RefPtr<Gdk::Pixbuf>& pixbuf);
+
+    private:
+
+        // Return the key of a source at a size.
+        static std::string get_key (
+            const std::string& source, int width, int height);
+
+};
+
+#endif
@@ -0,0 +1,160 @@
+/*
+pixbufsink.cpp - Decode the body of a response as an image.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <iostream>
+
+#include "pixbufsink.h"
+#include "resampler.h"
+
+PixbufSink::PixbufSink ():
+    received (), loader (Gdk::PixbufLoader::create ()), pixbuf (), width (-1),
+    height (-1), preserve_aspect (true), target_width (-1),
+    target_height (-1)
+{
+    loader->signal_size_prepared ().connect (
+        sigc::mem_fun (*this, &PixbufSink::on_size_prepared));
+}
+
+PixbufSink::~PixbufSink ()
+{
+    // Nobody is going to use the image (the request didn't run)
+    discard ();
+}
+
+void PixbufSink::set_size (int width, int height, bool preserve_aspect)
+{
+    this->width = width;
+    this->height = height;
+    this->preserve_aspect = preserve_aspect;
+}
+
+void PixbufSink::on_size_prepared (int width, int height)
+{
+    if (this->width <= 0 or this->height <= 0 or width <= 0 or height <= 0) {
+        return;
+    }
+    int w = this->width;
+    int h = this->height;
+    if (preserve_aspect) {
+        // Fit the image into the box, as gdk_pixbuf_new_from_file_at_scale
+        if (static_cast<long>(width) * h > static_cast<long>(height) * w) {
+            h = std::max (1L, static_cast<long>(height) * w / width);
+        } else {
+            w = std::max (1L, static_cast<long>(width) * h / height);
+        }
+    }
+
+    // Vector images are rendered at any size by their decoder
+    auto format = loader->get_format ();
+    if (format.is_scalable ()) {
+        loader->set_size (w, h);
+        return;
+    }
+    target_width = w;
+    target_height = h;
+
+    /* The JPEG decoder reduces the image to 1/2, 1/4 or 1/8 almost for free.
+       Take the largest reduction that is not smaller than the final size;
+       the rest is done by the resampler. */
+    if (format.get_name () == "jpeg") {
+        int k = MAX_JPEG_REDUCTION;
+        while (k > 0 and (((width + (1 << k) - 1) >> k) < w
+                          or ((height + (1 << k) - 1) >> k) < h))
+        {
+            k--;
+        }
+        if (k > 0) {
+            loader->set_size ((width + (1 << k) - 1) >> k,
+                              (height + (1 << k) - 1) >> k);
+        }
+    }
+}
+
+void PixbufSink::set_length (size_t length)
+{
+    received.set_length (length);
+}
+
+bool PixbufSink::write (const char* bytes, size_t length)
+{
+    if (not loader) {
+        return false;
+    }
+    return received.write (bytes, length);
+}
+
+void PixbufSink::close ()
+{
+    if (loader) {
+        auto bytes = received.get_buffer ().get_view ();
+        try {
+            if (not bytes.empty ()) {
+                loader->write (
+                    reinterpret_cast<const guint8*>(bytes.data ()),
+                    bytes.size ());
+            }
+            loader->close ();
+            pixbuf = loader->get_pixbuf ();
+            resize ();
+        } catch (Glib::Error& e) {
+            // Truncated, corrupted or unknown image; no image is not an error
+            if (not bytes.empty ()) {
+                std::cerr << "cannot decode image: " << e.what () << std::endl;
+            }
+        }
+        received.clear ();
+        loader.reset ();
+    }
+}
+
+void PixbufSink::discard ()
+{
+    received.clear ();
+    close ();
+}
+
+void PixbufSink::resize ()
+{
+    if (not pixbuf or target_width <= 0 or target_height <= 0
+        or (pixbuf->get_width () == target_width
+            and pixbuf->get_height () == target_height))
+    {
+        return;
+    }
+    auto channels = pixbuf->get_n_channels ();
+    if (pixbuf->get_bits_per_sample () != 8
+        or channels != (pixbuf->get_has_alpha () ? 4 : 3))
+    {
+        // Not a layout of the resampler
+        pixbuf = pixbuf->scale_simple (
+            target_width, target_height, Gdk::INTERP_BILINEAR);
+        return;
+    }
+    auto scaled = Gdk::Pixbuf::create (Gdk::COLORSPACE_RGB,
+        pixbuf->get_has_alpha (), 8, target_width, target_height);
+    Resampler::resize (pixbuf->get_pixels (), pixbuf->get_width (),
+                       pixbuf->get_height (), pixbuf->get_rowstride (),
+                       scaled->get_pixels (), target_width, target_height,
+                       scaled->get_rowstride (), channels);
+    pixbuf = scaled;
+}
@@ -0,0 +1,105 @@
+/*
+pixbufsink.h - Decode the body of a response as an image.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PIXBUFSINK_H
+#define PIXBUFSINK_H
+
+#include <gdkmm/pixbufloader.h>
+
+#include "bodysink.h"
+#include "memorysink.h"
+
+/* Decode the body with a PixbufLoader. The bytes are only kept as they
+   arrive, in the transfers thread, and the whole image is decoded at once
+   on close, in the thread of the caller, so that a slow image doesn't
+   delay the other transfers. The decoding is not progressive: the image
+   is not available until the body is complete. A sink destroyed without
+   being closed drops its bytes. Only scalable images are decoded at their final size; the rest are
+   decoded at full size (or reduced by the JPEG decoder) and resized with
+   the Resampler. */
+class PixbufSink: public BodySink {
+
+    private:
+
+        // Largest reduction of the JPEG decoder, as a power of 2 (1/8)
+        static const int MAX_JPEG_REDUCTION = 3;
+
+        // The bytes of the body, waiting to be decoded
+        MemorySink received;
+
+        // The decoder
+        Glib::RefPtr<Gdk::PixbufLoader> loader;
+
+        // The decoded image
+        Glib::RefPtr<Gdk::Pixbuf> pixbuf;
+
+        // Size requested for the image, or -1 to keep the original size
+        int width;
+        int height;
+
+        // True to fit the image into the size keeping its aspect ratio
+        bool preserve_aspect;
+
+        // Final size of the image, known when the decoder reads the header,
+        // or -1 to keep the decoded size
+        int target_width;
+        int target_height;
+
+    public:
+
+        PixbufSink ();
+        ~PixbufSink ();
+
+        // Return the decoder (to configure it before the transfer).
+        inline Glib::RefPtr<Gdk::PixbufLoader>& get_loader () { return loader; }
+
+        /* Give the image the given size, decoding it directly at that size
+           when the format allows it. */
+        void set_size (int width, int height, bool preserve_aspect);
+
+        /* Return the decoded image, or an empty pointer if the image could not
+           be decoded. Call it after close. */
+        inline Glib::RefPtr<Gdk::Pixbuf> get_pixbuf () { return pixbuf; }
+
+        // Implementation of the BodySink interface.
+        void set_length (size_t length);
+
+        // Implementation of the BodySink interface.
+        bool write (const char* bytes, size_t length);
+
+        // Implementation of the BodySink interface. Decode the image.
+        void close ();
+
+        // Drop the bytes received without decoding them (nobody waits).
+        void discard ();
+
+    private:
+
+        // The decoder knows the original size of the image.
+        void on_size_prepared (int width, int height);
+
+        // Resize the decoded image to the target size
+        void resize ();
+
+};
+
+#endif
@@ -0,0 +1,40 @@
+/*
+posterlistener.h - Interface to receive the poster request results.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef POSTERLISTENER_H
+#define POSTERLISTENER_H
+
+#include <memory>
+
+#include "pictureresult.h"
+
+class PosterListener {
+
+    public:
+
+        // Notify that the poster of a title is ready
+        virtual void poster_received (
+            std::unique_ptr<PictureResult>& result) = 0;
+
+};
+
+#endif
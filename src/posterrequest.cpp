@@ -0,0 +1,48 @@
+/*
+posterrequest.cpp - Request the poster of a title.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "posterrequest.h"
+
+PosterRequest::PosterRequest (const std::string& server_address,
+                              const std::string& title_id,
+                              int width,
+                              int height,
+                              ImageCache& cache,
+                              PixbufCache& pixbuf_cache,
+                              PosterListener& listener):
+    PictureRequest (server_address, title_id, get_source (title_id), width,
+        height, false, cache, pixbuf_cache),
+    listener (listener)
+{}
+
+PosterRequest::~PosterRequest ()
+{}
+
+std::string PosterRequest::get_source (const std::string& title_id)
+{
+    return "getposter?id=" + escape (title_id);
+}
+
+void PosterRequest::notify (std::unique_ptr<PictureResult>& result)
+{
+    listener.poster_received (result);
+}
@@ -64,6 +64,14 @@ class ProfileButton {
         // Return the GTK button
         inline Gtk::Button& get_button () { return button; }
 
+        // Set the profile's picture, already scaled to the button size.
+        inline void set_picture (const Glib::RefPtr<Gdk::Pixbuf>& picture)
+            { image.set (picture); }
+
+        // Return true if the profile's picture has been set.
+        inline bool has_picture () const
+            { return image.get_storage_type () != Gtk::IMAGE_EMPTY; }
+
     private:
 
         // The button has been clicked.
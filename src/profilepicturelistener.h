@@ -24,8 +24,18 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #ifndef PROFILEPICTURELISTENER_H
 #define PROFILEPICTURELISTENER_H
 
+#include <memory>
+
+#include "pictureresult.h"
+
 class ProfilePictureListener {
 
+    public:
+
+        // Notify that the picture of a profile is ready
+        virtual void profile_picture_received (
+            std::unique_ptr<PictureResult>& result) = 0;
+
 };
 
 #endif
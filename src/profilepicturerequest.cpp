@@ -0,0 +1,48 @@
+/*
+profilepicturerequest.cpp - Request the picture of a profile.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "profilepicturerequest.h"
+
+ProfilePictureRequest::ProfilePictureRequest (
+    const std::string& server_address,
+    const std::string& profile,
+    int size,
+    ImageCache& cache,
+    PixbufCache& pixbuf_cache,
+    ProfilePictureListener& listener):
+        PictureRequest (server_address, profile, get_source (profile), size,
+            size, true, cache, pixbuf_cache),
+        listener (listener)
+{}
+
+ProfilePictureRequest::~ProfilePictureRequest ()
+{}
+
+std::string ProfilePictureRequest::get_source (const std::string& profile)
+{
+    return "getprofilepicture?name=" + escape (profile);
+}
+
+void ProfilePictureRequest::notify (std::unique_ptr<PictureResult>& result)
+{
+    listener.profile_picture_received (result);
+}
@@ -0,0 +1,58 @@
+/*
+profilepicturerequest.h - Request the picture of a profile.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PROFILEPICTUREREQUEST_H
+#define PROFILEPICTUREREQUEST_H
+
+#include <string>
+
+#include "picturerequest.h"
+#include "profilepicturelistener.h"
+
+class ProfilePictureRequest: public PictureRequest {
+
+    private:
+
+        // Listener to receive the picture.
+        ProfilePictureListener& listener;
+
+    public:
+
+        ProfilePictureRequest (const std::string& server_address,
+                               const std::string& profile,
+                               int size,
+                               ImageCache& cache,
+                               PixbufCache& pixbuf_cache,
+                               ProfilePictureListener& listener);
+        ~ProfilePictureRequest ();
+
+        // Return the source of the picture in the memory cache.
+        static std::string get_source (const std::string& profile);
+
+    protected:
+
+        // Pass the result to the listener.
+        void notify (std::unique_ptr<PictureResult>& result);
+
+};
+
+#endif
@@ -0,0 +1,172 @@
+/*
+profilepicturesrequest.cpp - Request of several profile pictures at once.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <fstream>
+#include <glibmm/base64.h>
+#include <iostream>
+#include <rapidjson/document.h>
+
+#include "pixbufsink.h"
+#include "profilepicturerequest.h"
+#include "profilepicturesrequest.h"
+
+ProfilePicturesRequest::ProfilePicturesRequest (
+    const std::string& server_address,
+    const std::vector<std::string>& profiles,
+    int size,
+    ImageCache& image_cache,
+    PixbufCache& pixbuf_cache,
+    ProfilePictureListener& listener,
+    const Fallback& fallback):
+        Request (server_address), profiles (profiles), size (size),
+        image_cache (image_cache), pixbuf_cache (pixbuf_cache),
+        listener (listener), fallback (fallback)
+{}
+
+ProfilePicturesRequest::~ProfilePicturesRequest ()
+{}
+
+std::string ProfilePicturesRequest::get_api_function () const
+{
+    std::string function = "getprofilepictures";
+    for (size_t i = 0; i < profiles.size (); i++) {
+        function += (i ? "&name=" : "?name=") + escape (profiles[i]);
+    }
+    return function;
+}
+
+RequestPriority::Class ProfilePicturesRequest::get_default_priority () const
+{
+    return RequestPriority::VISIBLE;
+}
+
+void ProfilePicturesRequest::run ()
+{
+    std::vector<std::unique_ptr<PictureResult> > results;
+    std::vector<std::string> missing;
+    auto supported = true;
+    rapidjson::Document d;
+
+    // Don't decode pictures that nobody will see
+    auto followers = land ();
+    if (is_cancelled () and followers.empty ()) {
+        return;
+    }
+
+    try {
+        get_json_response (d);
+        if (not d.HasMember ("pictures") or not d["pictures"].IsObject ()) {
+            throw std::runtime_error (
+                "getprofilepictures request: no 'pictures' object in json");
+        }
+        const rapidjson::Value& pictures = d["pictures"];
+        for (auto& p: profiles) {
+            Glib::RefPtr<Gdk::Pixbuf> pixbuf;
+            std::string bytes;
+            rapidjson::Value name (
+                rapidjson::StringRef (p.c_str (), p.size ()));
+            auto it = pictures.FindMember (name);
+            if (it != pictures.MemberEnd () and it->value.IsString ()) {
+                bytes = Glib::Base64::decode (std::string (
+                    it->value.GetString (), it->value.GetStringLength ()));
+                pixbuf = decode (bytes);
+            }
+            if (pixbuf) {
+                store (p, bytes);
+                pixbuf_cache.add (ProfilePictureRequest::get_source (p), size,
+                                  size, pixbuf);
+                results.push_back (std::make_unique<PictureResult> (p));
+                results.back ()->set_pixbuf (pixbuf);
+            } else {
+                missing.push_back (p);
+            }
+        }
+    } catch (std::runtime_error& e) {
+        std::cerr << e.what () << std::endl;
+        auto code = get_response_code ();
+        supported = code != NOT_FOUND and code != NOT_IMPLEMENTED;
+        results.clear ();
+        missing = profiles;
+    }
+
+    // The identical requests get the same pictures
+    for (auto& f: followers) {
+        deliver (static_cast<ProfilePicturesRequest&>(*f), results, missing,
+                 supported);
+    }
+    if (not is_cancelled ()) {
+        deliver (*this, results, missing, supported);
+    }
+}
+
+Glib::RefPtr<Gdk::Pixbuf> ProfilePicturesRequest::decode (
+    const std::string& bytes)
+{
+    PixbufSink sink;
+    sink.set_size (size, size, true);
+    sink.write (bytes.data (), bytes.size ());
+    sink.close ();
+    return sink.get_pixbuf ();
+}
+
+void ProfilePicturesRequest::store (const std::string& profile,
+                                    const std::string& bytes)
+{
+    /* The picture wasn't modified after the batch, so it is revalidated
+       with the Last-Modified of the batch. The ETag of the batch is not
+       valid for the picture alone. Without it, the picture would be
+       downloaded again anyway. */
+    auto& last_modified = get_last_modified ();
+    if (last_modified.empty ()) {
+        return;
+    }
+    auto key = PictureRequest::get_cache_key (
+        get_server_address (), ProfilePictureRequest::get_source (profile));
+    auto temp_path = image_cache.get_temp_path (key);
+    if (temp_path.empty ()) {
+        return;
+    }
+    std::ofstream file (temp_path, std::ios::binary);
+    file.write (bytes.data (), bytes.size ());
+    file.close ();
+    if (not file) {
+        std::cerr << "cannot write cache file " << temp_path << std::endl;
+        image_cache.discard (temp_path);
+        return;
+    }
+    image_cache.store (key, temp_path, "", last_modified);
+}
+
+void ProfilePicturesRequest::deliver (
+    ProfilePicturesRequest& request,
+    const std::vector<std::unique_ptr<PictureResult> >& results,
+    const std::vector<std::string>& missing,
+    bool supported)
+{
+    for (auto& r: results) {
+        auto copy = std::make_unique<PictureResult> (*r);
+        request.listener.profile_picture_received (copy);
+    }
+    if (not missing.empty () or not supported) {
+        request.fallback (missing, supported);
+    }
+}
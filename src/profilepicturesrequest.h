@@ -0,0 +1,121 @@
+/*
+profilepicturesrequest.h - Request of several profile pictures at once.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PROFILEPICTURESREQUEST_H
+#define PROFILEPICTURESREQUEST_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "imagecache.h"
+#include "pictureresult.h"
+#include "pixbufcache.h"
+#include "profilepicturelistener.h"
+#include "request.h"
+
+/* Download the pictures of several profiles in a single round trip. The
+   server sends a JSON object that maps each profile name to its picture,
+   encoded in base64. The pictures are decoded at their final size and
+   kept in the memory cache, like the ones requested one by one. They are
+   also kept in the image cache, to revalidate them one by one later: the
+   batch has no validators of each picture, so it is only used for the
+   pictures that aren't cached.
+
+   The profiles whose picture doesn't come in the response are passed to
+   the fallback, to request them one by one. */
+class ProfilePicturesRequest: public Request {
+
+    public:
+
+        /* Function to request one by one the pictures of the given
+           profiles. The flag is false if the server doesn't know the batch
+           function, so that it is not used again. */
+        typedef std::function<void (const std::vector<std::string>& profiles,
+                                    bool supported)> Fallback;
+
+    private:
+
+        // HTTP response codes of a server without the batch function
+        static const long NOT_FOUND = 404;
+        static const long NOT_IMPLEMENTED = 501;
+
+        // Names of the profiles
+        std::vector<std::string> profiles;
+
+        // Size of the square to fit the pictures in
+        int size;
+
+        // Cache of the downloaded pictures
+        ImageCache& image_cache;
+
+        // Cache of the decoded pictures
+        PixbufCache& pixbuf_cache;
+
+        // Listener to receive the pictures.
+        ProfilePictureListener& listener;
+
+        // Function to request the pictures not received
+        Fallback fallback;
+
+    public:
+
+        ProfilePicturesRequest (const std::string& server_address,
+                                const std::vector<std::string>& profiles,
+                                int size,
+                                ImageCache& image_cache,
+                                PixbufCache& pixbuf_cache,
+                                ProfilePictureListener& listener,
+                                const Fallback& fallback);
+        ~ProfilePicturesRequest ();
+
+        // Run this request.
+        void run ();
+
+    protected:
+
+        // Return the API function to call.
+        std::string get_api_function () const;
+
+        // Pictures are visible unless the view tells otherwise.
+        RequestPriority::Class get_default_priority () const;
+
+    private:
+
+        // Decode a picture, or return null.
+        Glib::RefPtr<Gdk::Pixbuf> decode (const std::string& bytes);
+
+        // Keep the picture of a profile in the image cache.
+        void store (const std::string& profile, const std::string& bytes);
+
+        /* Pass the pictures received to the listener of a request, and the
+           rest of the profiles to its fallback. */
+        static void deliver (
+            ProfilePicturesRequest& request,
+            const std::vector<std::unique_ptr<PictureResult> >& results,
+            const std::vector<std::string>& missing,
+            bool supported);
+
+};
+
+#endif
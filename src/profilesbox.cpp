@@ -42,44 +42,88 @@ void ProfilesBox::on_show ()
     box.get_hscrollbar ()->hide ();
 }
 
-void ProfilesBox::set (const std::vector<std::string>& profiles)
+ProfilesBox::Changes ProfilesBox::set (
+    const std::vector<std::string>& profiles)
 {
-    // Remove the absent buttons
-    for (auto it = buttons.begin(); it != buttons.end();) {
-        bool found = false;
-        for (auto& p: profiles) {
-            if ((*it)->get_name () == p) {
-                found = true;
-                break;
-            }
+    Changes changes = {{}, {}, false};
+
+    // Index the current buttons by name. They are taken as they are placed,
+    // so the ones left at the end are the absent profiles
+    std::vector<std::unique_ptr<ProfileButton> > old_buttons;
+    old_buttons.swap (buttons);
+    std::unordered_map<std::string, size_t> old_positions;
+    for (size_t i = 0; i < old_buttons.size (); i++) {
+        old_positions[old_buttons[i]->get_name ()] = i;
+    }
+    index.clear ();
+
+    // Place the buttons in the order of the server
+    size_t last_position = 0;
+    for (auto& p: profiles) {
+        if (index.count (p)) {
+            // Repeated profile
+            continue;
         }
-        if (not found) {
-            // The current button is not among the new profiles. Remove it.
-            profile_buttons_box.remove ((*it)->get_button ());
-            it = buttons.erase (it);
+        std::unique_ptr<ProfileButton> b;
+        auto it = old_positions.find (p);
+        if (it != old_positions.end ()) {
+            // The buttons kept must be in the same relative order
+            if (it->second < last_position) {
+                changes.reordered = true;
+            }
+            last_position = it->second;
+            b = std::move (old_buttons[it->second]);
+            old_positions.erase (it);
         } else {
-            it++;
+            b = std::make_unique<ProfileButton> (p, size, listener);
+            profile_buttons_box.pack_start (b->get_button (), false, false);
+            b->get_button ().show_all ();
+            changes.added.push_back (p);
         }
+        index[p] = b.get ();
+        buttons.push_back (std::move (b));
     }
 
-    // Add the new buttons
-    for (auto& p: profiles) {
-        bool found = false;
-        for (auto& b: buttons) {
-            if (b->get_name () == p) {
-                found = true;
-                break;
+    // Remove the buttons of the absent profiles
+    for (auto& p: old_positions) {
+        changes.removed.push_back (p.first);
+        profile_buttons_box.remove (old_buttons[p.second]->get_button ());
+    }
+
+    // Put the buttons in order, if the new ones are not at the end
+    auto children = profile_buttons_box.get_children ();
+    auto child = children.begin ();
+    for (auto& b: buttons) {
+        if (*child != &b->get_button ()) {
+            for (size_t i = 0; i < buttons.size (); i++) {
+                profile_buttons_box.reorder_child (
+                    buttons[i]->get_button (), i);
             }
+            break;
         }
-        if (not found) {
-            // The current profile is not among the current buttons. Add it.
-            auto b = std::make_unique<ProfileButton> (p, size, listener);
-            profile_buttons_box.pack_start (b->get_button (), false, false);
-            buttons.push_back (std::move (b));
+        child++;
+    }
+    return changes;
+}
+
+void ProfilesBox::get_missing_pictures (std::vector<std::string>& names) const
+{
+    for (auto& b: buttons) {
+        if (not b->has_picture ()) {
+            names.push_back (b->get_name ());
         }
     }
 }
 
+void ProfilesBox::set_picture (const std::string& profile,
+                               const Glib::RefPtr<Gdk::Pixbuf>& picture)
+{
+    auto it = index.find (profile);
+    if (it != index.end ()) {
+        it->second->set_picture (picture);
+    }
+}
+
 bool ProfilesBox::set_focus (int index)
 {
     if (index >= buttons.size ()) {
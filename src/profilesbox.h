@@ -24,6 +24,7 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #define PROFILESBOX_H
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <gtkmm/box.h>
 #include <gtkmm/scrolledwindow.h>
@@ -47,11 +48,26 @@ class ProfilesBox {
         // Box inside the scrolled window
         Gtk::Box profile_buttons_box;
 
-        // List of the buttons
+        // List of the buttons, in the order of the server
         std::vector<std::unique_ptr<ProfileButton> > buttons;
 
+        // Index of the buttons by profile name
+        std::unordered_map<std::string, ProfileButton*> index;
+
     public:
 
+        // Changes made by set
+        struct Changes {
+            // Profiles whose buttons were added
+            std::vector<std::string> added;
+
+            // Profiles whose buttons were removed
+            std::vector<std::string> removed;
+
+            // True if the buttons kept changed their order
+            bool reordered;
+        };
+
         ProfilesBox (int size, ProfileButtonListener& listener);
         ~ProfilesBox ();
 
@@ -59,8 +75,16 @@ class ProfilesBox {
         inline Gtk::ScrolledWindow& get_box ()
             { return box; }
 
-        // Set the list of profiles
-        void set (const std::vector<std::string>& profiles);
+        /* Set the list of profiles, keeping the buttons of the profiles
+           already shown. Return the changes made. */
+        Changes set (const std::vector<std::string>& profiles);
+
+        // Add the profiles whose picture has not been set yet to names.
+        void get_missing_pictures (std::vector<std::string>& names) const;
+
+        // Set the picture of a profile.
+        void set_picture (const std::string& profile,
+                          const Glib::RefPtr<Gdk::Pixbuf>& picture);
 
         /* Give the focus to a given profile.
            Return true if any profile got the focus. */
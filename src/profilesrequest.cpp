@@ -26,36 +26,82 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #include "profilesrequest.h"
 #include "profilesresult.h"
 
-ProfilesRequest::ProfilesRequest (
-    const std::string& server_address, ProfilesListener& listener):
-        Request (server_address), listener(listener)
-{}
+ProfilesRequest::ProfilesRequest (const std::string& server_address,
+                                  ProfilesListener& listener,
+                                  const std::string& etag,
+                                  const std::string& last_modified):
+    Request (server_address), listener (listener), etag (etag),
+    last_modified (last_modified)
+{
+    set_validators (etag, last_modified);
+}
 
 ProfilesRequest::~ProfilesRequest ()
 {}
 
+std::string ProfilesRequest::get_api_function () const
+{
+    return "getprofiles";
+}
+
+std::string ProfilesRequest::get_key () const
+{
+    return Request::get_key () + "#" + etag + "#" + last_modified;
+}
+
 void ProfilesRequest::run ()
 {
     auto r = std::make_unique<ProfilesResult>();
     rapidjson::Document d;
 
+    // Don't parse results that nobody will see
+    auto followers = land ();
+    if (is_cancelled () and followers.empty ()) {
+        return;
+    }
+
     try {
-        get_json_request ("getprofiles", d);
-        if (not d.HasMember ("profiles")) {
-            std::cerr << "getprofiles request: no 'profiles' member in json"
-                << std::endl;
-            r->set_error (true);
+        check_transfer ();
+        if (is_not_modified ()) {
+            // The listener has the list already, there is nothing to parse
+            r->set_unchanged (true);
+            r->set_validators (etag, last_modified);
+            r->set_error (false);
         } else {
-            const rapidjson::Value& profiles_array = d["profiles"];
-            for (rapidjson::SizeType i = 0; i < profiles_array.Size (); i++) {
-                r->add (profiles_array[i].GetString ());
+            get_json_response (d);
+            if (not d.HasMember ("profiles") or not d["profiles"].IsArray ()) {
+                std::cerr << "getprofiles request: no 'profiles' list in json"
+                    << std::endl;
+                r->set_error (true);
+            } else {
+                const rapidjson::Value& profiles_array = d["profiles"];
+                for (rapidjson::SizeType i = 0; i < profiles_array.Size ();
+                     i++)
+                {
+                    auto& p = profiles_array[i];
+                    if (not p.IsString ()) {
+                        throw std::runtime_error (
+                            "getprofiles request: invalid profile in json");
+                    }
+                    r->add (std::string (p.GetString (),
+                                         p.GetStringLength ()));
+                }
+                r->set_validators (get_etag (), get_last_modified ());
+                r->set_error (false);
             }
-            r->set_error (false);
         }
     } catch (std::runtime_error& e) {
         std::cerr << e.what () << std::endl;
         r->set_error (true);
     }
-    listener.profiles_received (r);
+
+    // Pass a copy of the result to the identical requests
+    for (auto& f: followers) {
+        auto copy = std::make_unique<ProfilesResult> (*r);
+        static_cast<ProfilesRequest&>(*f).listener.profiles_received (copy);
+    }
+    if (not is_cancelled ()) {
+        listener.profiles_received (r);
+    }
 }
 
@@ -35,15 +35,32 @@ class ProfilesRequest: public Request {
         // Listener to receive the event of profiles received.
         ProfilesListener& listener;
 
+        // Validators of the list the listener has, if any
+        std::string etag;
+        std::string last_modified;
+
     public:
 
-        ProfilesRequest (
-            const std::string& server_address, ProfilesListener& listener);
+        /* Request the list of profiles. If the validators of the list the
+           listener has are given, the list is only sent if it changed. */
+        ProfilesRequest (const std::string& server_address,
+                         ProfilesListener& listener,
+                         const std::string& etag = "",
+                         const std::string& last_modified = "");
         ~ProfilesRequest ();
 
         // Run this request.
         void run ();
 
+        /* Return the key of this request, that includes the validators, as
+           the requests with other validators may get other responses. */
+        std::string get_key () const;
+
+    protected:
+
+        // Return the API function to call.
+        std::string get_api_function () const;
+
 };
 
 #endif
@@ -23,7 +23,8 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #include "profilesresult.h"
 
 ProfilesResult::ProfilesResult ():
-    RequestResult (), profiles ()
+    RequestResult (), profiles (), unchanged (false), etag (),
+    last_modified ()
 {}
 
 ProfilesResult::~ProfilesResult ()
@@ -35,14 +35,21 @@ class ProfilesResult: public RequestResult {
         // List of profiles
         std::vector<std::string> profiles;
 
+        // True if the list is the same as the one of the validators sent
+        bool unchanged;
+
+        // Validators of the list, to poll it again
+        std::string etag;
+        std::string last_modified;
+
     public:
 
         ProfilesResult ();
         ~ProfilesResult ();
 
         // Add a profile.
-        inline void add (const std::string& profile)
-            { profiles.push_back (profile); }
+        inline void add (std::string&& profile)
+            { profiles.push_back (std::move (profile)); }
 
         // Return the list of profiles.
         inline std::vector<std::string>& get_profiles () { return profiles; }
@@ -50,6 +57,24 @@ class ProfilesResult: public RequestResult {
         // Return the number of profiles.
         inline int size () const { return profiles.size (); }
 
+        /* Return true if the list didn't change since the validators sent.
+           The list is empty then. */
+        inline bool is_unchanged () const { return unchanged; }
+
+        // Set the unchanged state.
+        inline void set_unchanged (bool unchanged)
+            { this->unchanged = unchanged; }
+
+        // Return the validators of the list.
+        inline const std::string& get_etag () const { return etag; }
+        inline const std::string& get_last_modified () const
+            { return last_modified; }
+
+        // Set the validators of the list.
+        inline void set_validators (const std::string& etag,
+                                    const std::string& last_modified)
+            { this->etag = etag; this->last_modified = last_modified; }
+
 };
 
 #endif
@@ -21,48 +21,6 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 */
 
 /*
-static gboolean
-profiles_view_update_picture (PictureRequest *r)
-{
-    GdkPixbuf *p = NULL;
-    GInputStream *gis;
-
-    if (r->error) {
-        p = gdk_pixbuf_new_from_file_at_scale (paths_get_default_picture(),
-            PROFILE_PICTURE_SIZE, PROFILE_PICTURE_SIZE, TRUE, NULL);
-    } else {
-        if (r->picture->len > 0) {
-            gis = g_memory_input_stream_new_from_data (
-                r->picture->data, r->picture->len, NULL);
-            p = gdk_pixbuf_new_from_stream_at_scale (gis,
-                PROFILE_PICTURE_SIZE, PROFILE_PICTURE_SIZE, TRUE, NULL, NULL);
-            if (!p) {
-                warnx ("profiles_view_update_picture: cannot load profile "
-                    "picture");
-                p = gdk_pixbuf_new_from_file_at_scale (
-                    paths_get_default_picture(), PROFILE_PICTURE_SIZE,
-                    PROFILE_PICTURE_SIZE, TRUE, NULL);
-            }
-            g_object_unref (gis);
-        } else {
-            p = gdk_pixbuf_new_from_file_at_scale (paths_get_default_picture(),
-                PROFILE_PICTURE_SIZE, PROFILE_PICTURE_SIZE, TRUE, NULL);
-        }
-    }
-    const char *profile = (const char *)r->data;
-    profilesbox_set_picture (
-        &profiles_view.profiles_box, profile, p);
-    g_free (r->data);
-    request_picture_destroy (r);
-    return FALSE;
-}
-
-static void
-profiles_view_set_picture (PictureRequest *r)
-{
-    g_idle_add ((GSourceFunc)profiles_view_update_picture, r);
-}
-
 static void
 profiles_view_leave (const char *next_view)
 {
@@ -94,7 +52,8 @@ profiles_view_profile_clicked (GtkWidget *widget, gpointer user_data)
 
 ProfilesView::ProfilesView (ViewControllerInterface& controller):
     BarView (controller),
-    exit_button (Paths::get_image ("off-black"),
+    exit_button (controller.get_icon_atlas (),
+        Paths::get_image ("off-black"),
         Paths::get_image ("off-white"),
         get_bar ().get_height () - 2*BAR_ICON_MARGIN,
         sigc::mem_fun (*this, &ProfilesView::on_exit),
@@ -106,7 +65,10 @@ ProfilesView::ProfilesView (ViewControllerInterface& controller):
     new_profile_button_box (Gtk::ORIENTATION_HORIZONTAL),
     new_profile_button ("New profile"),
     profile_got_focus (false),
-    button_got_focus (false)
+    button_got_focus (false),
+    pictures_token (),
+    profiles_etag (),
+    profiles_last_modified ()
 {
     // Populate the menu bar
     get_bar ().add_back (exit_button.get_button ());
@@ -142,18 +104,39 @@ ProfilesView::~ProfilesView ()
 
 void ProfilesView::show ()
 {
-    get_controller ().get_core ().request_profiles (*this);
+    get_controller ().get_core ().request_profiles (
+        *this, profiles_etag, profiles_last_modified);
 }
 
 void ProfilesView::profiles_received (std::unique_ptr<ProfilesResult>& result)
 {
-    this->profiles = std::move(result);
-    Glib::signal_idle ().connect (
-        sigc::mem_fun (*this, &ProfilesView::on_profiles_received));
+    std::shared_ptr<ProfilesResult> r (std::move (result));
+    get_controller ().get_main_queue ().push (
+        sigc::bind (sigc::mem_fun (*this, &ProfilesView::on_profiles_received),
+            r));
+}
+
+void ProfilesView::profile_picture_received (
+    std::unique_ptr<PictureResult>& result)
+{
+    // The picture is already decoded and scaled, just show it
+    std::shared_ptr<PictureResult> r (std::move (result));
+    get_controller ().get_main_queue ().push ([this, r] () {
+        if (r->get_pixbuf ()) {
+            profiles_box.set_picture (r->get_id (), r->get_pixbuf ());
+        }
+    });
 }
 
 void ProfilesView::profile_clicked (const std::string& profile)
 {
+    // The pictures still on their way won't be shown
+    if (pictures_token) {
+        pictures_token->cancel ();
+        pictures_token.reset ();
+    }
+    get_controller ().get_core ().set_profile (profile);
+    get_controller ().switch_view ("medias");
 }
 
 void ProfilesView::on_new_profile_clicked ()
@@ -161,33 +144,45 @@ void ProfilesView::on_new_profile_clicked ()
 
 }
 
-bool ProfilesView::on_profiles_received ()
+void ProfilesView::on_profiles_received (
+    const std::shared_ptr<ProfilesResult>& profiles)
 {
     auto retry = false;
 
     // Exit if this view is not visible
     if (get_controller ().get_current_view () != &get_box ()) {
-        return false;
+        return;
     }
     // Check the profiles received
     if (profiles->get_error ()) {
         // Some error ocurred, show the message
         show_label ("Cannot get list of profiles");
         retry = true;
+        // The list shown is gone, the next one must be sent in full
+        profiles_etag.clear ();
+        profiles_last_modified.clear ();
+    } else if (profiles->is_unchanged ()) {
+        // The list shown is up to date, there is nothing to reconcile
+        if (stack.get_visible_child () == &label) {
+            retry = true;
+        } else {
+            std::vector<std::string> added;
+            request_pictures (added);
+        }
     } else {
+        profiles_etag = profiles->get_etag ();
+        profiles_last_modified = profiles->get_last_modified ();
         if (not profiles->size ()) {
             // No profiles available
             show_label ("No profiles available");
             retry = true;
         } else {
             // Set the profiles list
-            profiles_box.set (profiles->get_profiles ());
-            // Request the profiles pictures
-            for (auto& p: profiles->get_profiles ()) {
-                get_controller ().get_core ().request_profile_picture (
-                    p, *this);
-            }
-            stack.set_visible_child ("profiles-box");
+            auto changes = profiles_box.set (profiles->get_profiles ());
+            request_pictures (changes.added);
+            stack.set_visible_child ("profiles");
+            get_controller ().get_startup_trace ().mark_on_draw (
+                stack, "profiles shown");
         }
     }
     set_default_focus ();
@@ -198,7 +193,6 @@ bool ProfilesView::on_profiles_received ()
             sigc::mem_fun (*this, &ProfilesView::on_timeout),
             QUERY_PROFILES_TIMEOUT);
     }
-    return false;
 }
 
 void ProfilesView::on_exit ()
@@ -212,10 +206,26 @@ void ProfilesView::on_exit ()
 
 bool ProfilesView::on_timeout ()
 {
-    get_controller ().get_core ().request_profiles (*this);
+    get_controller ().get_core ().request_profiles (
+        *this, profiles_etag, profiles_last_modified);
     return false;
 }
 
+void ProfilesView::request_pictures (std::vector<std::string>& added)
+{
+    // Request the pictures of the new profiles only, or again the missing
+    // ones if their requests were cancelled
+    std::vector<std::string> names;
+    if (not pictures_token) {
+        pictures_token = std::make_shared<CancelToken> ();
+        profiles_box.get_missing_pictures (names);
+    } else {
+        names.swap (added);
+    }
+    get_controller ().get_core ().request_profile_pictures (
+        names, PROFILE_PICTURE_SIZE, *this, pictures_token);
+}
+
 void ProfilesView::show_label (const std::string& text)
 {
     label.set_text (text);
@@ -70,15 +70,19 @@ class ProfilesView: public BarView, ProfilesListener, ProfilePictureListener,
         // Button to create a new profile
         Gtk::Button new_profile_button;
 
-        // List of profiles to show
-        std::unique_ptr<ProfilesResult> profiles;
-
         // True if a profile button got the focus
         bool profile_got_focus;
 
         // True if the new profile button got the focus
         bool button_got_focus;
 
+        // Token to cancel the pictures requested
+        std::shared_ptr<CancelToken> pictures_token;
+
+        // Validators of the list of profiles shown, to poll it
+        std::string profiles_etag;
+        std::string profiles_last_modified;
+
     public:
 
         ProfilesView (ViewControllerInterface& controller);
@@ -90,6 +94,9 @@ class ProfilesView: public BarView, ProfilesListener, ProfilePictureListener,
         // Implementation of the interface ProfilesListener.
         void profiles_received (std::unique_ptr<ProfilesResult>& result);
 
+        // Implementation of the ProfilePictureListener interface.
+        void profile_picture_received (std::unique_ptr<PictureResult>& result);
+
         // Implementation of the ProfileButtonListener interface.
         void profile_clicked (const std::string& profile);
 
@@ -102,11 +109,16 @@ class ProfilesView: public BarView, ProfilesListener, ProfilePictureListener,
         void on_new_profile_clicked ();
 
         // Executed when the list of profiles is received
-        bool on_profiles_received ();
+        void on_profiles_received (
+            const std::shared_ptr<ProfilesResult>& profiles);
 
         // Executed when the timeout is expired
         bool on_timeout ();
 
+        /* Request the pictures of the profiles added, or of all the
+           profiles without picture if the requests were cancelled. */
+        void request_pictures (std::vector<std::string>& added);
+
         // Put a text in the info label
         void show_label (const std::string& text);
 
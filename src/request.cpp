@@ -20,18 +20,27 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <glib.h>
+#include <iostream>
+
 #include "curl.h"
 #include "request.h"
 
-#include <iostream>
-
 Request::Request (const std::string& server_address):
-    server_address (server_address),
-    request_thread (&Request::run_thread, this)
+    server_address (server_address), curl (), memory_sink (),
+    sink (&memory_sink), headers (nullptr), code (CURLE_OK),
+    response_code (0), skip_headers (false), etag (), last_modified (),
+    flights (nullptr), followers (), token (), priority ()
 {}
 
 Request::~Request ()
-{}
+{
+    curl_slist_free_all (headers);
+}
 
 /*
 static int
@@ -101,57 +110,261 @@ cleanup:
 }
 */
 
-Glib::RefPtr<Glib::ByteArray> Request::get_request (
-    const std::string& api_function)
-{
-    Curl curl;
-    auto url = server_address + "/api/" + api_function;
-    curl.setopt (CURLOPT_URL, url);
-    curl.setopt (CURLOPT_WRITEFUNCTION, &Request::receive);
-    auto buffer = Glib::ByteArray::create ();
-    curl.setopt (CURLOPT_WRITEDATA, &buffer);
-    curl.setopt (CURLOPT_FAILONERROR, 1);
-    curl.setopt (CURLOPT_FOLLOWLOCATION, 1);
-    curl.perform ();
-    return buffer;
-}
-
-void Request::get_json_request (
-    const std::string& api_function, rapidjson::Document& document)
-{
-    auto data = get_request (api_function);
-    // Force a null character at the end
-    const guint8 end[] = {0};
-    data->append (end, 1);
-    document.Parse (reinterpret_cast<const char*>(data->get_data ()));
+void Request::start (std::unique_ptr<Curl> curl)
+{
+    this->curl = std::move (curl);
+    memory_sink.clear ();
+    this->curl->setopt (CURLOPT_URL, get_url ());
+    this->curl->setopt (CURLOPT_WRITEFUNCTION, &Request::receive);
+    this->curl->setopt (CURLOPT_WRITEDATA, sink);
+    this->curl->setopt (CURLOPT_HEADERFUNCTION, &Request::receive_header);
+    this->curl->setopt (CURLOPT_HEADERDATA, this);
+    if (headers) {
+        this->curl->setopt (CURLOPT_HTTPHEADER, headers);
+    }
+    if (token) {
+        this->curl->setopt (CURLOPT_XFERINFOFUNCTION, &Request::progress);
+        this->curl->setopt (CURLOPT_XFERINFODATA, this);
+        this->curl->setopt (CURLOPT_NOPROGRESS, 0L);
+    }
+    this->curl->setopt (CURLOPT_FAILONERROR, 1);
+    this->curl->setopt (CURLOPT_FOLLOWLOCATION, 1);
+    this->curl->setopt (CURLOPT_PRIVATE, this);
+}
+
+std::unique_ptr<Curl> Request::finish (CURLcode code)
+{
+    this->code = code;
+    if (curl) {
+        response_code = curl->get_response_code ();
+    }
+    return std::move (curl);
+}
+
+std::string Request::get_url () const
+{
+    return server_address + "/api/" + get_api_function ();
+}
+
+std::string Request::get_key () const
+{
+    return get_url ();
+}
+
+bool Request::is_abandoned ()
+{
+    if (not is_cancelled ()) {
+        return false;
+    }
+    return not flights or flights->is_abandoned (*this);
+}
+
+RequestPriority::Class Request::get_priority () const
+{
+    return priority ? priority->get () : get_default_priority ();
+}
+
+RequestPriority::Class Request::get_effective_priority ()
+{
+    return flights ? flights->get_priority (*this) : get_priority ();
+}
+
+RequestPriority::Class Request::get_default_priority () const
+{
+    return RequestPriority::INTERACTIVE;
+}
+
+std::vector<std::unique_ptr<Request> > Request::land ()
+{
+    std::vector<std::unique_ptr<Request> > waiting;
+    if (flights) {
+        for (auto& f: flights->land (*this)) {
+            if (not f->is_cancelled ()) {
+                waiting.push_back (std::move (f));
+            }
+        }
+    }
+    return waiting;
+}
+
+void Request::add_header (const std::string& header)
+{
+    auto list = curl_slist_append (headers, header.c_str ());
+    if (not list) {
+        throw std::runtime_error ("cannot add header " + header);
+    }
+    headers = list;
+}
+
+void Request::set_validators (const std::string& etag,
+                              const std::string& last_modified)
+{
+    if (not etag.empty ()) {
+        add_header ("If-None-Match: " + etag);
+    }
+    if (not last_modified.empty ()) {
+        add_header ("If-Modified-Since: " + last_modified);
+    }
+}
+
+void Request::check_transfer () const
+{
+    if (code != CURLE_OK) {
+        throw std::runtime_error ("request " + get_api_function ()
+            + " failed: " + curl_easy_strerror (code));
+    }
+}
+
+std::string_view Request::get_response ()
+{
+    check_transfer ();
+    return memory_sink.get_buffer ().get_view ();
+}
+
+void Request::get_json_response (rapidjson::Document& document)
+{
+    check_transfer ();
+    // The buffer has room for the null character at the end
+    document.ParseInsitu (memory_sink.get_buffer ().c_str ());
     // Check that the returned string is indeed a valid JSON obect
     if (not document.IsObject ()) {
         throw std::runtime_error (
-            "request " + api_function + " returned invalid JSON string");
+            "request " + get_api_function () + " returned invalid JSON string");
     } else {
         // Check the return code
-        if (not document.HasMember ("code")) {
-            throw std::runtime_error (
-                "request " + api_function + " returned invalid JSON string");
-        } else {
-            auto code = document["code"].GetInt ();
-            if (code) {
-                throw std::runtime_error ("request " + api_function
-                    + " returned with code " + std::to_string (code));
-            }
-        }
+        auto has_code = document.HasMember ("code")
+            and document["code"].IsInt ();
+        check_code (has_code, has_code ? document["code"].GetInt () : 0);
     }
 }
 
-void Request::run_thread ()
+std::string Request::escape (const std::string& s)
 {
-    run ();
+    auto escaped = g_uri_escape_string (s.c_str (), nullptr, true);
+    std::string result (escaped);
+    g_free (escaped);
+    return result;
+}
+
+void Request::check_code (bool has_code, int code) const
+{
+    if (not has_code) {
+        throw std::runtime_error (
+            "request " + get_api_function () + " returned invalid JSON string");
+    } else if (code) {
+        throw std::runtime_error ("request " + get_api_function ()
+            + " returned with code " + std::to_string (code));
+    }
 }
 
 size_t Request::receive (void* buffer, size_t size, size_t nmemb, void* userp)
 {
-    auto byte_array = static_cast<Glib::RefPtr<Glib::ByteArray>*>(userp);
-    (*byte_array)->append (static_cast<const guint8*>(buffer), nmemb);
-    return nmemb;
+    auto length = size * nmemb;
+    auto sink = static_cast<BodySink*>(userp);
+    // Returning a different length aborts the transfer. The exceptions
+    // can't go through cURL, so they abort it too.
+    try {
+        if (sink->write (static_cast<const char*>(buffer), length)) {
+            return length;
+        }
+    } catch (...) {
+    }
+    return 0;
+}
+
+int Request::progress (void* userp, curl_off_t dltotal, curl_off_t dlnow,
+                       curl_off_t ultotal, curl_off_t ulnow)
+{
+    // Returning non zero aborts the transfer
+    try {
+        return static_cast<Request*>(userp)->is_abandoned () ? 1 : 0;
+    } catch (...) {
+        return 1;
+    }
+}
+
+size_t Request::receive_header (
+    void* buffer, size_t size, size_t nitems, void* userp)
+{
+    auto length = size * nitems;
+    auto request = static_cast<Request*>(userp);
+    // Returning a different length aborts the transfer
+    try {
+        if (request->process_header (
+                static_cast<const char*>(buffer), length))
+        {
+            return length;
+        }
+    } catch (...) {
+    }
+    return 0;
 }
 
+bool Request::process_header (const char* header, size_t length)
+{
+    static const char STATUS_LINE[] = "HTTP/";
+    static const char CONTENT_LENGTH[] = "content-length";
+    static const char ETAG[] = "etag";
+    static const char LAST_MODIFIED[] = "last-modified";
+
+    /* A status line starts a new response. With the redirections followed,
+       only the headers of the final response are kept. */
+    if (length > sizeof (STATUS_LINE) - 1
+        and memcmp (header, STATUS_LINE, sizeof (STATUS_LINE) - 1) == 0)
+    {
+        auto space = static_cast<const char*>(memchr (header, ' ', length));
+        long code = space ? strtol (space + 1, nullptr, 10) : 0;
+        skip_headers = is_intermediate (code);
+        etag.clear ();
+        last_modified.clear ();
+        return true;
+    }
+    if (skip_headers) {
+        return true;
+    }
+
+    // Split the header into name and value, skip the blank line
+    auto colon = static_cast<const char*>(memchr (header, ':', length));
+    if (not colon) {
+        return true;
+    }
+    std::string name (header, colon - header);
+    std::transform (name.begin (), name.end (), name.begin (),
+        [] (unsigned char c) { return std::tolower (c); });
+    auto begin = colon + 1;
+    auto end = header + length;
+    while (begin < end and isspace (static_cast<unsigned char>(*begin))) {
+        begin++;
+    }
+    while (end > begin and isspace (static_cast<unsigned char>(end[-1]))) {
+        end--;
+    }
+    std::string value (begin, end - begin);
+
+    // Reserve the memory for the body as soon as its length is known
+    if (name == CONTENT_LENGTH) {
+        try {
+            sink->set_length (std::stoul (value));
+        } catch (std::logic_error&) {
+            // Malformed header, the buffer will grow on demand
+        }
+    } else if (name == ETAG) {
+        etag = value;
+    } else if (name == LAST_MODIFIED) {
+        last_modified = value;
+    }
+    header_received (name, value);
+    return true;
+}
+
+bool Request::is_intermediate (long response_code)
+{
+    // The informational responses and the redirections followed by cURL;
+    // 304 (not modified) is a final response
+    switch (response_code) {
+        case 301: case 302: case 303: case 307: case 308:
+            return true;
+        default:
+            return response_code >= 100 and response_code < 200;
+    }
+}
@@ -23,52 +23,225 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #ifndef REQUEST_H
 #define REQUEST_H
 
-#include <glibmm/bytearray.h>
+#include <memory>
 #include <rapidjson/document.h>
+#include <rapidjson/reader.h>
+#include <stdexcept>
 #include <string>
-#include <thread>
+#include <string_view>
+#include <vector>
+
+#include "bodysink.h"
+#include "canceltoken.h"
+#include "curl.h"
+#include "flights.h"
+#include "requestpriority.h"
+#include "memorysink.h"
 
 class Request {
 
     private:
 
-        // Thread that runs this request.
-        std::thread request_thread;
+        friend class Flights;
+
+        // HTTP response code of a conditional request whose data is the same
+        static const long NOT_MODIFIED = 304;
 
         // Server address
         std::string server_address;
 
+        // Handler that performs the transfer
+        std::unique_ptr<Curl> curl;
+
+        // Default destination of the response, in memory
+        MemorySink memory_sink;
+
+        // Destination of the response
+        BodySink* sink;
+
+        // Extra headers sent with the request
+        curl_slist* headers;
+
+        // Result of the transfer
+        CURLcode code;
+
+        // HTTP response code
+        long response_code;
+
+        // True while receiving the headers of an intermediate response (an
+        // informational one or a redirection that is followed)
+        bool skip_headers;
+
+        // Validators of the response, to ask for it again only if changed
+        std::string etag;
+        std::string last_modified;
+
+        // Coalescer of this request, while it is in flight
+        Flights* flights;
+
+        // Identical requests waiting for the result of this one
+        std::vector<std::unique_ptr<Request> > followers;
+
+        // Token to cancel this request, if any
+        std::shared_ptr<CancelToken> token;
+
+        // Priority set by the view, if any
+        std::shared_ptr<RequestPriority> priority;
+
     public:
 
         Request (const std::string& server_address);
         virtual ~Request ();
 
-        // Return the thread that runs this request.
-        inline std::thread& get_thread () { return request_thread; }
+        // Prepare the transfer of this request in the given handler.
+        void start (std::unique_ptr<Curl> curl);
 
-        // Run this request.
+        // The transfer has finished. Return the handler used.
+        std::unique_ptr<Curl> finish (CURLcode code);
+
+        // Return the handler that performs the transfer.
+        inline Curl& get_curl () { return *curl; }
+
+        // Process the response of this request (the completion handler).
         virtual void run () = 0;
 
+        // Set the token to cancel this request.
+        inline void set_token (const std::shared_ptr<CancelToken>& token)
+            { this->token = token; }
+
+        // Return true if this request was cancelled.
+        inline bool is_cancelled () const
+            { return token and token->is_cancelled (); }
+
+        /* Return true if nobody waits for the result: this request and the
+           identical requests attached to it were cancelled. */
+        bool is_abandoned ();
+
+        // Set the priority of this request.
+        inline void set_priority (
+            const std::shared_ptr<RequestPriority>& priority)
+            { this->priority = priority; }
+
+        // Return the priority class of this request.
+        RequestPriority::Class get_priority () const;
+
+        /* Return the priority class to schedule this request: the most
+           urgent of this request and the identical ones attached to it. */
+        RequestPriority::Class get_effective_priority ();
+
+        // Return the URL of this request.
+        std::string get_url () const;
+
+        /* Return the key of this request. Requests with the same key get
+           the same result, so they are coalesced. */
+        virtual std::string get_key () const;
+
     protected:
 
-        // Make an HTTP request
-        Glib::RefPtr<Glib::ByteArray> get_request (
-            const std::string& api_function);
+        // Return the API function to call, with its arguments.
+        virtual std::string get_api_function () const = 0;
+
+        // Return the address of the server.
+        inline const std::string& get_server_address () const
+            { return server_address; }
+
+        // Return the priority class when the view doesn't set one.
+        virtual RequestPriority::Class get_default_priority () const;
+
+        /* Set the destination of the response. By default the response is
+           received in memory. The sink must live as long as this request. */
+        inline void set_sink (BodySink& sink) { this->sink = &sink; }
+
+        // Add a header to send with the request, as "Name: value".
+        void add_header (const std::string& header);
+
+        /* Make the request conditional: the server only sends the data if it
+           doesn't match the validators of a previous response. The empty
+           validators are not sent. */
+        void set_validators (const std::string& etag,
+                             const std::string& last_modified);
+
+        /* A header of the response has been received. The name is in lower
+           case. It is called from the transfers thread. */
+        virtual void header_received (
+            const std::string& name, const std::string& value) {}
+
+        /* Return the identical requests that were waiting for this one, to
+           pass them the result; the cancelled ones are left out. Call it
+           at the beginning of run; the requests are of the same class as
+           this one. */
+        std::vector<std::unique_ptr<Request> > land ();
+
+        // Return the HTTP response code, once the transfer has finished.
+        inline long get_response_code () const { return response_code; }
+
+        /* Return true if the data hasn't changed since the response of the
+           validators, so that the server sent no body. */
+        inline bool is_not_modified () const
+            { return response_code == NOT_MODIFIED; }
 
-        // Make an HTTP request and extract the returned JSON
-        void get_json_request (
-            const std::string& api_function, rapidjson::Document& document);
+        // Return the validators of the response (empty if not sent).
+        inline const std::string& get_etag () const { return etag; }
+        inline const std::string& get_last_modified () const
+            { return last_modified; }
+
+        // Throw if the transfer failed.
+        void check_transfer () const;
+
+        // Return a view of the data received in memory, or throw if the
+        // transfer failed. The view is valid while this request lives.
+        std::string_view get_response ();
+
+        /* Extract the returned JSON. The document is parsed in place, so its
+           strings are only valid while this request lives. */
+        void get_json_response (rapidjson::Document& document);
+
+        /* Parse the returned JSON in place, passing the events to a SAX
+           handler. The handler must implement get_has_code and get_code
+           to return the code returned by the server. */
+        template <typename Handler>
+        void parse_json_response (Handler& handler);
+
+        // Return a string escaped to be put into an URL.
+        static std::string escape (const std::string& s);
 
     private:
 
-        // Bootstrap of the thread function
-        void run_thread ();
+        // Throw if the server didn't return a code or returned an error
+        void check_code (bool has_code, int code) const;
 
         // Function to receive data from the HTTP request
         static size_t receive (
             void* buffer, size_t size, size_t nmemb, void* userp);
 
+        // Function to abort the transfer when nobody waits for it
+        static int progress (void* userp, curl_off_t dltotal, curl_off_t dlnow,
+                             curl_off_t ultotal, curl_off_t ulnow);
+
+        // Function to receive the headers from the HTTP request
+        static size_t receive_header (
+            void* buffer, size_t size, size_t nitems, void* userp);
+
+        // Process a header of the response, return false to abort
+        bool process_header (const char* header, size_t length);
+
+        // Return true if the response with this code is followed by another
+        static bool is_intermediate (long response_code);
+
 };
 
+template <typename Handler>
+void Request::parse_json_response (Handler& handler)
+{
+    check_transfer ();
+    rapidjson::InsituStringStream stream (memory_sink.get_buffer ().c_str ());
+    rapidjson::Reader reader;
+    if (not reader.Parse<rapidjson::kParseInsituFlag> (stream, handler)) {
+        throw std::runtime_error (
+            "request " + get_api_function () + " returned invalid JSON string");
+    }
+    check_code (handler.get_has_code (), handler.get_code ());
+}
+
 #endif
 
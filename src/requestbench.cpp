@@ -0,0 +1,182 @@
+/*
+requestbench.cpp - Benchmark of the transfers of the RequestManager.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <err.h>
+#include <getopt.h>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "curl.h"
+#include "request.h"
+#include "requestmanager.h"
+
+// Size of a grid of posters (5 columns x 6 rows), and grids loaded
+static const int DEFAULT_COUNT = 30;
+static const int DEFAULT_ROUNDS = 10;
+
+// Count of the finished requests, to wait for the end of a round
+class Counter {
+
+    private:
+
+        int finished;
+        int failed;
+        std::mutex mutex;
+        std::condition_variable cond;
+
+    public:
+
+        Counter (): finished (0), failed (0), mutex (), cond () {}
+
+        // A request has finished.
+        void add (bool ok)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished++;
+                failed += not ok;
+            }
+            cond.notify_one ();
+        }
+
+        // Wait until n requests have finished. Return the failed ones.
+        int wait (int n)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait (lock, [this, n] {return finished >= n;});
+            return failed;
+        }
+
+};
+
+// A request of a fixed API function, that only checks its transfer
+class BenchRequest: public Request {
+
+    private:
+
+        std::string function;
+        Counter& counter;
+
+    public:
+
+        BenchRequest (const std::string& server_address,
+                      const std::string& function,
+                      Counter& counter):
+            Request (server_address), function (function), counter (counter)
+        {}
+
+        void run ()
+        {
+            auto ok = true;
+            try {
+                check_transfer ();
+            } catch (std::runtime_error& e) {
+                std::cerr << e.what () << std::endl;
+                ok = false;
+            }
+            counter.add (ok);
+        }
+
+    protected:
+
+        std::string get_api_function () const { return function; }
+
+};
+
+static void
+print_help (const char* program)
+{
+    std::cout << "Usage: " << program << " [options] ADDR FUNCTION\n"
+"Request the API function FUNCTION of the server ADDR in rounds of\n"
+"simultaneous requests, through the RequestManager of the application.\n"
+"Options:\n"
+"  -2          Use HTTP/2 (multiplexed with https only).\n"
+"  -c FILE     Verify the server with the certificates of FILE.\n"
+"  -w NUM      Number of threads to run the requests.\n"
+"  -n NUM      Requests in each round (default: 30).\n"
+"  -r NUM      Number of rounds (default: 10)." << std::endl;
+    exit (0);
+}
+
+int
+main (int argc, char* argv[])
+{
+    auto http2 = false;
+    auto workers = RequestManager::get_default_workers ();
+    int count = DEFAULT_COUNT;
+    int rounds = DEFAULT_ROUNDS;
+    int o;
+    while ((o = getopt (argc, argv, "h2c:w:n:r:")) != -1) {
+        switch (o) {
+            case 'h':
+                print_help (argv[0]);
+            case '2':
+                http2 = true;
+                break;
+            case 'c':
+                Curl::set_ca_file (optarg);
+                break;
+            case 'w':
+                workers = atoi (optarg);
+                break;
+            case 'n':
+                count = atoi (optarg);
+                break;
+            case 'r':
+                rounds = atoi (optarg);
+                break;
+            default:
+                return EXIT_FAILURE;
+        }
+    }
+    if (argc - optind != 2 or count <= 0 or rounds <= 0) {
+        errx (1, "error: wrong arguments, see -h");
+    }
+    std::string address = argv[optind];
+    std::string function = argv[optind + 1];
+
+    RequestManager manager (workers, http2);
+    Counter counter;
+    auto start = std::chrono::steady_clock::now ();
+    for (int i = 0; i < rounds; i++) {
+        for (int j = 0; j < count; j++) {
+            std::unique_ptr<Request> r =
+                std::make_unique<BenchRequest> (address, function, counter);
+            manager.add (r);
+        }
+        counter.wait ((i + 1) * count);
+    }
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now () - start;
+    auto failed = counter.wait (rounds * count);
+
+    std::cout << (http2 ? "HTTP/2" : "HTTP/1.1") << ": " << rounds
+        << " rounds of " << count << " requests in " << elapsed.count ()
+        << " ms (" << elapsed.count () / rounds << " ms per round), "
+        << failed << " failed" << std::endl;
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -20,45 +20,201 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 <http://www.gnu.org/licenses/>.
 */
 
-#include <chrono>
+#include <iostream>
 
 #include "requestmanager.h"
 
-#include <iostream>
-
-using namespace std::chrono_literals;
+unsigned int RequestManager::get_default_workers ()
+{
+    // hardware_concurrency may return 0 if the value is not computable
+    auto n = std::thread::hardware_concurrency ();
+    return n ? n : 1;
+}
 
-RequestManager::RequestManager ():
-    requests (), stop (false), collector_thread (&RequestManager::run, this)
-{}
+RequestManager::RequestManager (unsigned int num_workers, bool http2):
+    pending (), waiting (), transfers (), completed (), multi (), workers (),
+    stop (false), http2 (http2), queue_depth (0), in_flight (0), finished (0)
+{
+    multi.setopt (CURLMOPT_MAX_HOST_CONNECTIONS, MAX_HOST_CONNECTIONS);
+    if (http2) {
+        if (Curl::supports_http2 ()) {
+            multi.setopt (CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        } else {
+            std::cerr << "HTTP/2 not supported by libcurl, using HTTP/1.1"
+                << std::endl;
+            this->http2 = false;
+        }
+    }
+    if (not num_workers) {
+        num_workers = 1;
+    }
+    for (unsigned int i = 0; i < num_workers; i++) {
+        workers.emplace_back (&RequestManager::run_worker, this);
+    }
+    transfers_thread = std::thread (&RequestManager::run_transfers, this);
+}
 
 RequestManager::~RequestManager ()
 {
+    // Stop the transfers first, then the workers, so that no more requests
+    // reach the workers
     stop = true;
-    collector_thread.join ();
+    multi.wakeup ();
+    transfers_thread.join ();
+    {
+        std::lock_guard<std::mutex> lock(completed_mutex);
+    }
+    completed_cond.notify_all ();
+    for (auto& w: workers) {
+        w.join ();
+    }
 }
 
 void RequestManager::add (std::unique_ptr <Request>& request)
 {
-    std::lock_guard<std::mutex> lock(requests_mutex);
-    requests.push_back (std::move (request));
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        pending.push_back (std::move (request));
+        queue_depth++;
+    }
+    multi.wakeup ();
 }
 
-void RequestManager::run ()
+void RequestManager::print_stats (std::ostream& out) const
 {
+    out << "requests: " << finished << " finished, " << in_flight
+        << " transferring, " << queue_depth << " queued" << std::endl;
+}
+
+void RequestManager::run_worker ()
+{
+    while (true) {
+        std::unique_ptr<Request> request;
+        {
+            std::unique_lock<std::mutex> lock(completed_mutex);
+            completed_cond.wait (
+                lock, [this] {return stop or completed.size ();});
+            if (stop) {
+                return;
+            }
+            request = std::move (completed.front ());
+            completed.pop_front ();
+            queue_depth--;
+        }
+        request->run ();
+
+        // Free it here, outside the lock
+        request.reset ();
+        finished++;
+    }
+}
+
+void RequestManager::run_transfers ()
+{
+    void* userp;
+    CURLcode code;
+
     while (not stop) {
-        if (requests.size ()) {
-            std::unique_ptr<Request> request;
-            {
-                std::lock_guard<std::mutex> lock(requests_mutex);
-                request = std::move (requests.front ());
-                requests.pop_front ();
+        try {
+            start_transfers ();
+            multi.perform ();
+            auto finished = false;
+            while (multi.next_done (userp, code)) {
+                complete (static_cast<Request*> (userp), code);
+                finished = true;
             }
-            request->get_thread ().join ();
-            std::cout << "request joined" << std::endl;
-        } else {
-            std::this_thread::sleep_for (2s);
+            // Start the waiting transfers at once if some finished
+            if (not finished or waiting.empty ()) {
+                multi.poll (POLL_TIMEOUT);
+            }
+        } catch (std::runtime_error& e) {
+            std::cerr << e.what () << std::endl;
+        }
+    }
+
+    // Abort the transfers still running
+    for (auto& t: transfers) {
+        multi.remove (t.first->get_curl ());
+        Curl::release (t.first->finish (CURLE_ABORTED_BY_CALLBACK));
+    }
+    transfers.clear ();
+    waiting.clear ();
+    in_flight = 0;
+}
+
+void RequestManager::start_transfers ()
+{
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        for (auto& r: pending) {
+            waiting.push_back (std::move (r));
+        }
+        pending.clear ();
+    }
+
+    // Start the most urgent requests, the oldest first for the same class
+    auto max_transfers = http2 ? MAX_TRANSFERS_HTTP2 : MAX_TRANSFERS;
+    while (transfers.size () < max_transfers and not waiting.empty ()) {
+        auto best = waiting.end ();
+        auto best_priority = RequestPriority::PREFETCH;
+        for (auto it = waiting.begin (); it != waiting.end ();) {
+            if ((*it)->is_abandoned ()) {
+                // Nobody waits for the result, don't start the transfer
+                (*it)->finish (CURLE_ABORTED_BY_CALLBACK);
+                push_completed (std::move (*it));
+                it = waiting.erase (it);
+                continue;
+            }
+            auto priority = (*it)->get_effective_priority ();
+            if (best == waiting.end () or priority < best_priority) {
+                best = it;
+                best_priority = priority;
+            }
+            it++;
+        }
+        if (best != waiting.end ()) {
+            start (std::move (*best));
+            waiting.erase (best);
+        }
+    }
+}
+
+void RequestManager::start (std::unique_ptr<Request> r)
+{
+    try {
+        r->start (Curl::acquire ());
+        if (http2) {
+            r->get_curl ().enable_http2 ();
         }
+        multi.add (r->get_curl ());
+        auto p = r.get ();
+        transfers[p] = std::move (r);
+        queue_depth--;
+        in_flight++;
+    } catch (std::runtime_error& e) {
+        // The transfer couldn't start, let the request handle the error
+        std::cerr << e.what () << std::endl;
+        Curl::release (r->finish (CURLE_FAILED_INIT));
+        push_completed (std::move (r));
     }
 }
 
+void RequestManager::complete (Request* request, CURLcode code)
+{
+    auto it = transfers.find (request);
+    multi.remove (request->get_curl ());
+    Curl::release (request->finish (code));
+    in_flight--;
+    queue_depth++;
+    push_completed (std::move (it->second));
+    transfers.erase (it);
+}
+
+void RequestManager::push_completed (std::unique_ptr<Request> request)
+{
+    {
+        std::lock_guard<std::mutex> lock(completed_mutex);
+        completed.push_back (std::move (request));
+    }
+    completed_cond.notify_one ();
+}
@@ -23,42 +23,128 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #ifndef REQUESTMANAGER_H
 #define REQUESTMANAGER_H
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <list>
+#include <map>
 #include <mutex>
+#include <ostream>
 #include <thread>
+#include <vector>
 
+#include "curl.h"
 #include "request.h"
 
 class RequestManager {
 
     private:
 
-        // The list of requests
-        std::list<std::unique_ptr<Request> > requests;
+        // Maximum time to wait for activity in the transfers, in ms
+        static const int POLL_TIMEOUT = 1000;
 
-        // Thread that collects other threads
-        std::thread collector_thread;
+        // Maximum number of simultaneous connections to the server (the
+        // rest of transfers wait inside the engine for a free connection)
+        static const long MAX_HOST_CONNECTIONS = 6;
 
-        // Order to stop the collector thread
-        bool stop;
+        /* Maximum number of running transfers. The rest wait here, so that
+           the most urgent ones start first. With HTTP/2 the transfers share
+           a connection, so more of them can run. */
+        static const size_t MAX_TRANSFERS = MAX_HOST_CONNECTIONS;
+        static const size_t MAX_TRANSFERS_HTTP2 = 16;
 
-        // Mutex to protect the list of requests
-        std::mutex requests_mutex;
+        // The queue of requests added, not seen by the transfers thread yet
+        std::deque<std::unique_ptr<Request> > pending;
+
+        /* The requests waiting for a free transfer, in arrival order. Only
+           the transfers thread uses it. */
+        std::list<std::unique_ptr<Request> > waiting;
+
+        // The requests whose transfer is running, indexed by themselves
+        std::map<Request*, std::unique_ptr<Request> > transfers;
+
+        // The queue of transferred requests waiting for a worker
+        std::deque<std::unique_ptr<Request> > completed;
+
+        // Engine that multiplexes all the transfers
+        CurlMulti multi;
+
+        // Thread that drives the transfers
+        std::thread transfers_thread;
+
+        // Pool of threads that process (and then free) the transferred
+        // requests
+        std::vector<std::thread> workers;
+
+        // Order to stop the threads
+        std::atomic<bool> stop;
+
+        // Use HTTP/2 (and multiplex the transfers in a single connection)
+        bool http2;
+
+        // Mutex to protect the queue of pending requests
+        std::mutex pending_mutex;
+
+        // Mutex to protect the queue of transferred requests
+        std::mutex completed_mutex;
+
+        // Condition to wake up the workers when a transfer finishes
+        std::condition_variable completed_cond;
+
+        // Number of requests waiting for their transfer or for a worker
+        std::atomic<size_t> queue_depth;
+
+        // Number of running transfers
+        std::atomic<size_t> in_flight;
+
+        // Number of requests finished
+        std::atomic<size_t> finished;
 
     public:
 
-        RequestManager ();
+        // Return the default number of workers (the number of cores).
+        static unsigned int get_default_workers ();
+
+        RequestManager (unsigned int num_workers, bool http2);
         ~RequestManager ();
 
         // Add a request.
         void add (std::unique_ptr<Request>& request);
 
+        // Return the number of requests waiting for their transfer or for a
+        // worker.
+        inline size_t get_queue_depth () const { return queue_depth; }
+
+        // Return the number of running transfers.
+        inline size_t get_in_flight () const { return in_flight; }
+
+        // Return the number of requests finished so far.
+        inline size_t get_finished () const { return finished; }
+
+        // Print the counters of the requests.
+        void print_stats (std::ostream& out) const;
+
     private:
 
-        // Request collector function
-        void run ();
+        // Worker function, runs the transferred requests
+        void run_worker ();
+
+        // Transfers thread function
+        void run_transfers ();
+
+        /* Take the pending requests and start the transfers of the most
+           urgent waiting ones, while there are free transfers. */
+        void start_transfers ();
+
+        // Start the transfer of a request
+        void start (std::unique_ptr<Request> request);
+
+        // A transfer has finished, pass its request to the workers
+        void complete (Request* request, CURLcode code);
+
+        // Queue a transferred request for the workers
+        void push_completed (std::unique_ptr<Request> request);
 
 };
 
 #endif
-
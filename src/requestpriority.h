@@ -0,0 +1,61 @@
+/*
+requestpriority.h - Priority of the requests.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REQUESTPRIORITY_H
+#define REQUESTPRIORITY_H
+
+#include <atomic>
+
+/* The priority of a request, shared between a view and the request, so
+   that the view can re-rank it while it waits for its transfer. The
+   requests with a lower class start first. */
+class RequestPriority {
+
+    public:
+
+        // Priority classes, from the most to the least urgent
+        enum Class {
+            INTERACTIVE,    // The user waits for it (profiles, search...)
+            VISIBLE,        // A picture on screen
+            OFFSCREEN,      // A picture close to the screen
+            PREFETCH        // A picture that may be shown later
+        };
+
+    private:
+
+        // The current class
+        std::atomic<Class> value;
+
+    public:
+
+        RequestPriority (Class value);
+        ~RequestPriority ();
+
+        // Change the class.
+        inline void set (Class value) { this->value = value; }
+
+        // Return the class.
+        inline Class get () const { return value; }
+
+};
+
+#endif
@@ -0,0 +1,529 @@
+/*
+resampler.cpp - Resizing of 8-bit images with vectorized filters.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define RESAMPLER_AVX2
+#endif
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "resampler.h"
+
+// Half of the unit of the weights, to round
+static const int HALF = 1 << (Resampler::WEIGHT_BITS - 1);
+
+// Read the bytes of a pixel into an integer. The last pixel of a RGB row
+// is read without its following byte, that may be out of the buffer.
+static inline uint32_t load_pixel (const uint8_t* p, int channels, bool last)
+{
+    uint32_t v = 0;
+    memcpy (&v, p, channels == 4 or not last ? 4 : 3);
+    return v;
+}
+
+// Scalar versions
+
+static void filter_row_scalar (const uint8_t* src,
+                               uint8_t* dst,
+                               int dst_w,
+                               int channels,
+                               const int* first,
+                               const int16_t* weights,
+                               int taps)
+{
+    for (int i = 0; i < dst_w; i++) {
+        auto s = src + first[i] * channels;
+        auto w = weights + i * taps;
+        for (int c = 0; c < channels; c++) {
+            int acc = HALF;
+            for (int k = 0; k < taps; k++) {
+                acc += w[k] * s[k * channels + c];
+            }
+            dst[i * channels + c] = acc >> Resampler::WEIGHT_BITS;
+        }
+    }
+}
+
+static void filter_column_scalar (const uint8_t* const* rows,
+                                  const int16_t* weights,
+                                  int taps,
+                                  uint8_t* dst,
+                                  int start,
+                                  int length)
+{
+    for (int x = start; x < length; x++) {
+        int acc = HALF;
+        for (int k = 0; k < taps; k++) {
+            acc += weights[k] * rows[k][x];
+        }
+        dst[x] = acc >> Resampler::WEIGHT_BITS;
+    }
+}
+
+#if defined(__SSE2__)
+
+// Weights of two taps, to multiply pairs of 16-bit values with madd
+static inline __m128i pair_weights (int16_t w0, int16_t w1)
+{
+    return _mm_set1_epi32 (static_cast<uint16_t> (w0)
+        | (static_cast<uint32_t> (static_cast<uint16_t> (w1)) << 16));
+}
+
+static void filter_row_sse2 (const uint8_t* src,
+                             int src_w,
+                             uint8_t* dst,
+                             int dst_w,
+                             int channels,
+                             const int* first,
+                             const int16_t* weights,
+                             int taps)
+{
+    const __m128i zero = _mm_setzero_si128 ();
+    for (int i = 0; i < dst_w; i++) {
+        auto s = src + first[i] * channels;
+        auto w = weights + i * taps;
+        auto acc = _mm_set1_epi32 (HALF);
+
+        // Two taps at a time: interleave the channels of both pixels and
+        // multiply each pair by the pair of weights
+        for (int k = 0; k < taps; k += 2) {
+            auto p0 = _mm_cvtsi32_si128 (load_pixel (
+                s + k * channels, channels, first[i] + k == src_w - 1));
+            auto p1 = zero;
+            auto w1 = 0;
+            if (k + 1 < taps) {
+                p1 = _mm_cvtsi32_si128 (load_pixel (s + (k + 1) * channels,
+                    channels, first[i] + k + 1 == src_w - 1));
+                w1 = w[k + 1];
+            }
+            auto pairs = _mm_unpacklo_epi8 (_mm_unpacklo_epi8 (p0, p1), zero);
+            acc = _mm_add_epi32 (
+                acc, _mm_madd_epi16 (pairs, pair_weights (w[k], w1)));
+        }
+        acc = _mm_srai_epi32 (acc, Resampler::WEIGHT_BITS);
+        acc = _mm_packs_epi32 (acc, acc);
+        acc = _mm_packus_epi16 (acc, acc);
+        uint32_t out = _mm_cvtsi128_si32 (acc);
+        memcpy (dst + i * channels, &out, channels);
+    }
+}
+
+static void filter_column_sse2 (const uint8_t* const* rows,
+                                const int16_t* weights,
+                                int taps,
+                                uint8_t* dst,
+                                int length)
+{
+    const __m128i zero = _mm_setzero_si128 ();
+    int x = 0;
+    for (; x + 16 <= length; x += 16) {
+        auto acc0 = _mm_set1_epi32 (HALF);
+        auto acc1 = acc0;
+        auto acc2 = acc0;
+        auto acc3 = acc0;
+
+        // Two rows at a time: interleave their bytes and multiply each pair
+        // by the pair of weights
+        for (int k = 0; k < taps; k += 2) {
+            auto a = _mm_loadu_si128 (
+                reinterpret_cast<const __m128i*> (rows[k] + x));
+            auto b = zero;
+            auto w1 = 0;
+            if (k + 1 < taps) {
+                b = _mm_loadu_si128 (
+                    reinterpret_cast<const __m128i*> (rows[k + 1] + x));
+                w1 = weights[k + 1];
+            }
+            auto w = pair_weights (weights[k], w1);
+            auto lo = _mm_unpacklo_epi8 (a, b);
+            auto hi = _mm_unpackhi_epi8 (a, b);
+            acc0 = _mm_add_epi32 (
+                acc0, _mm_madd_epi16 (_mm_unpacklo_epi8 (lo, zero), w));
+            acc1 = _mm_add_epi32 (
+                acc1, _mm_madd_epi16 (_mm_unpackhi_epi8 (lo, zero), w));
+            acc2 = _mm_add_epi32 (
+                acc2, _mm_madd_epi16 (_mm_unpacklo_epi8 (hi, zero), w));
+            acc3 = _mm_add_epi32 (
+                acc3, _mm_madd_epi16 (_mm_unpackhi_epi8 (hi, zero), w));
+        }
+        auto lo = _mm_packs_epi32 (
+            _mm_srai_epi32 (acc0, Resampler::WEIGHT_BITS),
+            _mm_srai_epi32 (acc1, Resampler::WEIGHT_BITS));
+        auto hi = _mm_packs_epi32 (
+            _mm_srai_epi32 (acc2, Resampler::WEIGHT_BITS),
+            _mm_srai_epi32 (acc3, Resampler::WEIGHT_BITS));
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (dst + x),
+                          _mm_packus_epi16 (lo, hi));
+    }
+    filter_column_scalar (rows, weights, taps, dst, x, length);
+}
+
+#endif
+
+#if defined(RESAMPLER_AVX2)
+
+// Same as filter_column_sse2, with 32 bytes at a time. The unpacks and the
+// packs work inside each 128-bit lane, so the bytes get back in order.
+__attribute__ ((target ("avx2")))
+static void filter_column_avx2 (const uint8_t* const* rows,
+                                const int16_t* weights,
+                                int taps,
+                                uint8_t* dst,
+                                int length)
+{
+    const __m256i zero = _mm256_setzero_si256 ();
+    int x = 0;
+    for (; x + 32 <= length; x += 32) {
+        auto acc0 = _mm256_set1_epi32 (HALF);
+        auto acc1 = acc0;
+        auto acc2 = acc0;
+        auto acc3 = acc0;
+        for (int k = 0; k < taps; k += 2) {
+            auto a = _mm256_loadu_si256 (
+                reinterpret_cast<const __m256i*> (rows[k] + x));
+            auto b = zero;
+            auto w1 = 0;
+            if (k + 1 < taps) {
+                b = _mm256_loadu_si256 (
+                    reinterpret_cast<const __m256i*> (rows[k + 1] + x));
+                w1 = weights[k + 1];
+            }
+            auto w = _mm256_set1_epi32 (static_cast<uint16_t> (weights[k])
+                | (static_cast<uint32_t> (static_cast<uint16_t> (w1)) << 16));
+            auto lo = _mm256_unpacklo_epi8 (a, b);
+            auto hi = _mm256_unpackhi_epi8 (a, b);
+            acc0 = _mm256_add_epi32 (
+                acc0, _mm256_madd_epi16 (_mm256_unpacklo_epi8 (lo, zero), w));
+            acc1 = _mm256_add_epi32 (
+                acc1, _mm256_madd_epi16 (_mm256_unpackhi_epi8 (lo, zero), w));
+            acc2 = _mm256_add_epi32 (
+                acc2, _mm256_madd_epi16 (_mm256_unpacklo_epi8 (hi, zero), w));
+            acc3 = _mm256_add_epi32 (
+                acc3, _mm256_madd_epi16 (_mm256_unpackhi_epi8 (hi, zero), w));
+        }
+        auto lo = _mm256_packs_epi32 (
+            _mm256_srai_epi32 (acc0, Resampler::WEIGHT_BITS),
+            _mm256_srai_epi32 (acc1, Resampler::WEIGHT_BITS));
+        auto hi = _mm256_packs_epi32 (
+            _mm256_srai_epi32 (acc2, Resampler::WEIGHT_BITS),
+            _mm256_srai_epi32 (acc3, Resampler::WEIGHT_BITS));
+        _mm256_storeu_si256 (reinterpret_cast<__m256i*> (dst + x),
+                             _mm256_packus_epi16 (lo, hi));
+    }
+    filter_column_scalar (rows, weights, taps, dst, x, length);
+}
+
+#endif
+
+#if defined(__ARM_NEON)
+
+static void filter_row_neon (const uint8_t* src,
+                             int src_w,
+                             uint8_t* dst,
+                             int dst_w,
+                             int channels,
+                             const int* first,
+                             const int16_t* weights,
+                             int taps)
+{
+    for (int i = 0; i < dst_w; i++) {
+        auto s = src + first[i] * channels;
+        auto w = weights + i * taps;
+        auto acc = vdupq_n_u32 (0);
+        for (int k = 0; k < taps; k++) {
+            auto p = vreinterpret_u8_u32 (vdup_n_u32 (load_pixel (
+                s + k * channels, channels, first[i] + k == src_w - 1)));
+            acc = vmlal_n_u16 (acc, vget_low_u16 (vmovl_u8 (p)), w[k]);
+        }
+        auto r = vqrshrn_n_u32 (acc, Resampler::WEIGHT_BITS);
+        auto b = vqmovn_u16 (vcombine_u16 (r, r));
+        uint32_t out = vget_lane_u32 (vreinterpret_u32_u8 (b), 0);
+        memcpy (dst + i * channels, &out, channels);
+    }
+}
+
+static void filter_column_neon (const uint8_t* const* rows,
+                                const int16_t* weights,
+                                int taps,
+                                uint8_t* dst,
+                                int length)
+{
+    int x = 0;
+    for (; x + 16 <= length; x += 16) {
+        auto acc0 = vdupq_n_u32 (0);
+        auto acc1 = acc0;
+        auto acc2 = acc0;
+        auto acc3 = acc0;
+        for (int k = 0; k < taps; k++) {
+            auto v = vld1q_u8 (rows[k] + x);
+            auto lo = vmovl_u8 (vget_low_u8 (v));
+            auto hi = vmovl_u8 (vget_high_u8 (v));
+            uint16_t w = weights[k];
+            acc0 = vmlal_n_u16 (acc0, vget_low_u16 (lo), w);
+            acc1 = vmlal_n_u16 (acc1, vget_high_u16 (lo), w);
+            acc2 = vmlal_n_u16 (acc2, vget_low_u16 (hi), w);
+            acc3 = vmlal_n_u16 (acc3, vget_high_u16 (hi), w);
+        }
+        auto lo = vcombine_u16 (
+            vqrshrn_n_u32 (acc0, Resampler::WEIGHT_BITS),
+            vqrshrn_n_u32 (acc1, Resampler::WEIGHT_BITS));
+        auto hi = vcombine_u16 (
+            vqrshrn_n_u32 (acc2, Resampler::WEIGHT_BITS),
+            vqrshrn_n_u32 (acc3, Resampler::WEIGHT_BITS));
+        vst1q_u8 (dst + x, vcombine_u8 (vqmovn_u16 (lo), vqmovn_u16 (hi)));
+    }
+    filter_column_scalar (rows, weights, taps, dst, x, length);
+}
+
+#endif
+
+void Resampler::resize (const uint8_t* src,
+                        int src_w,
+                        int src_h,
+                        int src_stride,
+                        uint8_t* dst,
+                        int dst_w,
+                        int dst_h,
+                        int dst_stride,
+                        int channels,
+                        Isa isa)
+{
+    if (not supports (isa)) {
+        isa = SCALAR;
+    }
+    Filter h_filter, v_filter;
+    make_filter (src_w, dst_w, h_filter);
+    make_filter (src_h, dst_h, v_filter);
+
+    // Filter the rows into an image of the final width. The colours are
+    // premultiplied by the alpha, in a copy of each row.
+    size_t row_bytes = static_cast<size_t> (dst_w) * channels;
+    std::vector<uint8_t> tmp (row_bytes * src_h);
+    std::vector<uint8_t> premultiplied (channels == 4 ? src_w * 4 : 0);
+    for (int y = 0; y < src_h; y++) {
+        auto row = src + static_cast<size_t> (y) * src_stride;
+        if (channels == 4) {
+            memcpy (premultiplied.data (), row, src_w * 4);
+            premultiply (premultiplied.data (), src_w);
+            row = premultiplied.data ();
+        }
+        filter_row (row, src_w, &tmp[y * row_bytes], dst_w, channels,
+                    h_filter, isa);
+    }
+
+    // Filter the columns into the destination
+    std::vector<const uint8_t*> rows (v_filter.taps);
+    for (int y = 0; y < dst_h; y++) {
+        for (int k = 0; k < v_filter.taps; k++) {
+            rows[k] = &tmp[(v_filter.first[y] + k) * row_bytes];
+        }
+        auto out = dst + static_cast<size_t> (y) * dst_stride;
+        filter_column (rows.data (), &v_filter.weights[y * v_filter.taps],
+                       v_filter.taps, out, row_bytes, isa);
+        if (channels == 4) {
+            unpremultiply (out, dst_w);
+        }
+    }
+}
+
+Resampler::Isa Resampler::get_best_isa ()
+{
+    static const Isa best = supports (NEON) ? NEON
+        : supports (AVX2) ? AVX2
+        : supports (SSE2) ? SSE2
+        : SCALAR;
+    return best;
+}
+
+bool Resampler::supports (Isa isa)
+{
+    switch (isa) {
+        case SSE2:
+#if defined(__SSE2__)
+            return true;
+#else
+            return false;
+#endif
+        case AVX2:
+#if defined(RESAMPLER_AVX2)
+            return __builtin_cpu_supports ("avx2");
+#else
+            return false;
+#endif
+        case NEON:
+#if defined(__ARM_NEON)
+            return true;
+#else
+            return false;
+#endif
+        default:
+            return true;
+    }
+}
+
+const char* Resampler::get_isa_name (Isa isa)
+{
+    switch (isa) {
+        case SSE2:
+            return "SSE2";
+        case AVX2:
+            return "AVX2";
+        case NEON:
+            return "NEON";
+        default:
+            return "scalar";
+    }
+}
+
+void Resampler::make_filter (int src_size, int dst_size, Filter& filter)
+{
+    // The filter is a triangle, widened to the size of a destination pixel
+    // in the source when the image is reduced
+    double scale = static_cast<double> (src_size) / dst_size;
+    double radius = std::max (scale, 1.0);
+    int taps = std::min (static_cast<int> (std::ceil (2 * radius)) + 1,
+                         src_size);
+
+    filter.taps = taps;
+    filter.first.resize (dst_size);
+    filter.weights.assign (static_cast<size_t> (dst_size) * taps, 0);
+    std::vector<double> w (taps);
+    for (int i = 0; i < dst_size; i++) {
+        double center = (i + 0.5) * scale - 0.5;
+        int lo = static_cast<int> (std::floor (center - radius)) + 1;
+        int hi = static_cast<int> (std::ceil (center + radius)) - 1;
+        int first = std::min (std::max (lo, 0), src_size - taps);
+
+        // The pixels out of the image take the value of the edge
+        std::fill (w.begin (), w.end (), 0.0);
+        double sum = 0;
+        for (int j = lo; j <= hi; j++) {
+            double x = 1 - std::abs (j - center) / radius;
+            if (x > 0) {
+                w[std::min (std::max (j, 0), src_size - 1) - first] += x;
+                sum += x;
+            }
+        }
+
+        // Round the weights so that they add up to exactly one
+        auto weights = &filter.weights[static_cast<size_t> (i) * taps];
+        int total = 0;
+        int largest = 0;
+        for (int k = 0; k < taps; k++) {
+            weights[k] = std::lround (w[k] / sum * (1 << WEIGHT_BITS));
+            total += weights[k];
+            if (weights[k] > weights[largest]) {
+                largest = k;
+            }
+        }
+        weights[largest] += (1 << WEIGHT_BITS) - total;
+        filter.first[i] = first;
+    }
+}
+
+void Resampler::filter_row (const uint8_t* src,
+                            int src_w,
+                            uint8_t* dst,
+                            int dst_w,
+                            int channels,
+                            const Filter& filter,
+                            Isa isa)
+{
+    auto first = filter.first.data ();
+    auto weights = filter.weights.data ();
+#if defined(__SSE2__)
+    // AVX2 has nothing to add to a pixel of 4 bytes
+    if (isa == SSE2 or isa == AVX2) {
+        filter_row_sse2 (src, src_w, dst, dst_w, channels, first, weights,
+                         filter.taps);
+        return;
+    }
+#endif
+#if defined(__ARM_NEON)
+    if (isa == NEON) {
+        filter_row_neon (src, src_w, dst, dst_w, channels, first, weights,
+                         filter.taps);
+        return;
+    }
+#endif
+    filter_row_scalar (src, dst, dst_w, channels, first, weights,
+                       filter.taps);
+}
+
+void Resampler::filter_column (const uint8_t* const* rows,
+                               const int16_t* weights,
+                               int taps,
+                               uint8_t* dst,
+                               int length,
+                               Isa isa)
+{
+#if defined(RESAMPLER_AVX2)
+    if (isa == AVX2) {
+        filter_column_avx2 (rows, weights, taps, dst, length);
+        return;
+    }
+#endif
+#if defined(__SSE2__)
+    if (isa == SSE2) {
+        filter_column_sse2 (rows, weights, taps, dst, length);
+        return;
+    }
+#endif
+#if defined(__ARM_NEON)
+    if (isa == NEON) {
+        filter_column_neon (rows, weights, taps, dst, length);
+        return;
+    }
+#endif
+    filter_column_scalar (rows, weights, taps, dst, 0, length);
+}
+
+void Resampler::premultiply (uint8_t* row, int w)
+{
+    for (int i = 0; i < w; i++, row += 4) {
+        int a = row[3];
+        for (int c = 0; c < 3; c++) {
+            row[c] = (row[c] * a + 127) / 255;
+        }
+    }
+}
+
+void Resampler::unpremultiply (uint8_t* row, int w)
+{
+    for (int i = 0; i < w; i++, row += 4) {
+        int a = row[3];
+        if (a and a != 255) {
+            for (int c = 0; c < 3; c++) {
+                row[c] = std::min (255, (row[c] * 255 + a / 2) / a);
+            }
+        }
+    }
+}
@@ -0,0 +1,123 @@
+/*
+resampler.h - Resizing of 8-bit images with vectorized filters.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <cstdint>
+#include <vector>
+
+/* Resize 8-bit RGB and RGBA images with a separable linear filter. When
+   the image is reduced, the filter is widened to cover the whole area of
+   the source pixels, as GDK_INTERP_BILINEAR does, instead of sampling
+   them. The alpha channel weights the colours, so that transparent pixels
+   don't darken the borders.
+
+   The rows are filtered first, then the columns, with 14-bit fixed point
+   weights. The inner loops use SSE2 or NEON, and AVX2 when the processor
+   supports it; a scalar version covers the rest. It only touches the
+   buffers, so it can run in any thread. */
+class Resampler {
+
+    public:
+
+        // Instruction set of the inner loops
+        enum Isa {
+            SCALAR,
+            SSE2,
+            AVX2,
+            NEON
+        };
+
+        // Bits of the fractional part of the weights
+        static const int WEIGHT_BITS = 14;
+
+    private:
+
+        // Weights of the source pixels of each destination pixel, along an
+        // axis. All of them have the same number of taps, the missing ones
+        // with weight 0.
+        struct Filter {
+            // Number of source pixels of each destination pixel
+            int taps;
+
+            // First source pixel of each destination pixel
+            std::vector<int> first;
+
+            // Weights, taps for each destination pixel
+            std::vector<int16_t> weights;
+        };
+
+    public:
+
+        /* Resize an image with 3 (RGB) or 4 (RGBA, not premultiplied)
+           channels. The strides are the bytes from a row to the next one.
+           The destination must not overlap the source. */
+        static void resize (const uint8_t* src,
+                            int src_w,
+                            int src_h,
+                            int src_stride,
+                            uint8_t* dst,
+                            int dst_w,
+                            int dst_h,
+                            int dst_stride,
+                            int channels,
+                            Isa isa = get_best_isa ());
+
+        // Return the fastest instruction set of this processor.
+        static Isa get_best_isa ();
+
+        // Return true if this build and processor support an instruction set.
+        static bool supports (Isa isa);
+
+        // Return the name of an instruction set.
+        static const char* get_isa_name (Isa isa);
+
+    private:
+
+        // Compute the filter to resize an axis from src_size to dst_size
+        static void make_filter (int src_size, int dst_size, Filter& filter);
+
+        // Filter the pixels of a row
+        static void filter_row (const uint8_t* src,
+                                int src_w,
+                                uint8_t* dst,
+                                int dst_w,
+                                int channels,
+                                const Filter& filter,
+                                Isa isa);
+
+        // Filter the bytes of a destination row from several source rows
+        static void filter_column (const uint8_t* const* rows,
+                                   const int16_t* weights,
+                                   int taps,
+                                   uint8_t* dst,
+                                   int length,
+                                   Isa isa);
+
+        // Multiply and divide the colours by the alpha of their pixels
+        static void premultiply (uint8_t* row, int w);
+        static void unpremultiply (uint8_t* row, int w);
+
+};
+
+#endif
@@ -0,0 +1,62 @@
+/*
+responsebuffer.cpp - Buffer where the response of a request is received.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include "responsebuffer.h"
+
+ResponseBuffer::ResponseBuffer ():
+    data (), size (0), capacity (0)
+{}
+
+ResponseBuffer::~ResponseBuffer ()
+{}
+
+void ResponseBuffer::reserve (size_t size)
+{
+    if (size + 1 > capacity) {
+        std::unique_ptr<char[]> new_data (new char[size + 1]);
+        if (this->size) {
+            std::memcpy (new_data.get (), data.get (), this->size);
+        }
+        data = std::move (new_data);
+        capacity = size + 1;
+    }
+}
+
+void ResponseBuffer::append (const char* bytes, size_t length)
+{
+    if (size + length + 1 > capacity) {
+        // Unknown or wrong size, grow geometrically
+        reserve (std::max (size + length, std::max (2 * size, MIN_CAPACITY)));
+    }
+    std::memcpy (data.get () + size, bytes, length);
+    size += length;
+}
+
+char* ResponseBuffer::c_str ()
+{
+    reserve (size);
+    data[size] = '\0';
+    return data.get ();
+}
@@ -0,0 +1,74 @@
+/*
+responsebuffer.h - Buffer where the response of a request is received.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef RESPONSEBUFFER_H
+#define RESPONSEBUFFER_H
+
+#include <memory>
+#include <string_view>
+
+/* The buffer always keeps room for one more byte than its contents, so that
+   a null terminator can be put at the end without reallocating. */
+class ResponseBuffer {
+
+    private:
+
+        // Minimum capacity to allocate when the size is unknown
+        static constexpr size_t MIN_CAPACITY = 4096;
+
+        // The memory
+        std::unique_ptr<char[]> data;
+
+        // Number of bytes used
+        size_t size;
+
+        // Number of bytes allocated
+        size_t capacity;
+
+    public:
+
+        ResponseBuffer ();
+        ~ResponseBuffer ();
+
+        // Make room for size bytes of contents (and the terminator).
+        void reserve (size_t size);
+
+        // Append some bytes at the end.
+        void append (const char* bytes, size_t length);
+
+        // Remove the contents (but keep the memory).
+        inline void clear () { size = 0; }
+
+        // Return the number of bytes in the buffer.
+        inline size_t get_size () const { return size; }
+
+        // Return a view of the contents. It is valid until the buffer is
+        // modified or destroyed.
+        inline std::string_view get_view () const
+            { return std::string_view (data.get (), size); }
+
+        // Return the contents followed by a null character.
+        char* c_str ();
+
+};
+
+#endif
@@ -0,0 +1,162 @@
+/*
+scalebench.cpp - Benchmark of the resampler against GdkPixbuf.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+#include <iostream>
+#include <vector>
+
+#include "resampler.h"
+
+// Sizes of a typical poster, as received and as shown
+static const int DEFAULT_SRC_W = 500;
+static const int DEFAULT_SRC_H = 740;
+static const int DEFAULT_DST_W = 182;
+static const int DEFAULT_DST_H = 268;
+static const int DEFAULT_ITERATIONS = 200;
+
+// Fill an image with gradients and some noise, like a photograph
+static GdkPixbuf*
+create_image (int w, int h, bool alpha)
+{
+    auto pixbuf = gdk_pixbuf_new (GDK_COLORSPACE_RGB, alpha, 8, w, h);
+    auto channels = gdk_pixbuf_get_n_channels (pixbuf);
+    auto stride = gdk_pixbuf_get_rowstride (pixbuf);
+    auto pixels = gdk_pixbuf_get_pixels (pixbuf);
+    srand (1);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            auto p = pixels + y * stride + x * channels;
+            p[0] = 255 * x / w;
+            p[1] = 255 * y / h;
+            p[2] = 128 + 127 * std::sin (x * 0.05 + y * 0.03);
+            for (int c = 0; c < 3; c++) {
+                p[c] = std::min (255, std::max (0, p[c] + rand () % 17 - 8));
+            }
+            if (alpha) {
+                p[3] = x < w / 8 ? 0 : 255 * y / h;
+            }
+        }
+    }
+    return pixbuf;
+}
+
+// Return the mean time of a function in microseconds
+template <typename F>
+static double
+measure (int iterations, F f)
+{
+    auto start = std::chrono::steady_clock::now ();
+    for (int i = 0; i < iterations; i++) {
+        f ();
+    }
+    std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now () - start;
+    return elapsed.count () / iterations;
+}
+
+static void
+run (int src_w, int src_h, int dst_w, int dst_h, int iterations, bool alpha)
+{
+    auto src = create_image (src_w, src_h, alpha);
+    auto channels = gdk_pixbuf_get_n_channels (src);
+    std::cout << src_w << "x" << src_h << " -> " << dst_w << "x" << dst_h
+        << ", " << channels << " channels" << std::endl;
+
+    // The reference
+    GdkPixbuf* reference = nullptr;
+    auto t = measure (iterations, [&] {
+        if (reference) {
+            g_object_unref (reference);
+        }
+        reference = gdk_pixbuf_scale_simple (
+            src, dst_w, dst_h, GDK_INTERP_BILINEAR);
+    });
+    std::cout << "  gdk-pixbuf bilinear: " << t << " us" << std::endl;
+
+    auto ref_stride = gdk_pixbuf_get_rowstride (reference);
+    auto ref_pixels = gdk_pixbuf_get_pixels (reference);
+    std::vector<uint8_t> dst (dst_w * dst_h * channels);
+    for (auto isa: {Resampler::SCALAR, Resampler::SSE2, Resampler::AVX2,
+                    Resampler::NEON})
+    {
+        if (not Resampler::supports (isa)) {
+            continue;
+        }
+        t = measure (iterations, [&] {
+            Resampler::resize (gdk_pixbuf_get_pixels (src), src_w, src_h,
+                               gdk_pixbuf_get_rowstride (src), dst.data (),
+                               dst_w, dst_h, dst_w * channels, channels, isa);
+        });
+
+        // Difference with the reference, in the visible pixels
+        long total = 0;
+        long count = 0;
+        int max = 0;
+        for (int y = 0; y < dst_h; y++) {
+            for (int x = 0; x < dst_w; x++) {
+                auto a = ref_pixels + y * ref_stride + x * channels;
+                auto b = &dst[(y * dst_w + x) * channels];
+                if (channels == 4 and a[3] < 16) {
+                    continue;
+                }
+                for (int c = 0; c < channels; c++) {
+                    int d = std::abs (a[c] - b[c]);
+                    total += d;
+                    max = std::max (max, d);
+                    count++;
+                }
+            }
+        }
+        std::cout << "  " << Resampler::get_isa_name (isa) << ": " << t
+            << " us, mean difference " << (count ? double (total) / count : 0)
+            << ", max difference " << max << std::endl;
+    }
+    g_object_unref (reference);
+    g_object_unref (src);
+}
+
+int
+main (int argc, char* argv[])
+{
+    if (argc != 1 and argc != 5 and argc != 6) {
+        std::cerr << "Usage: " << argv[0]
+            << " [SRC_W SRC_H DST_W DST_H [ITERATIONS]]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    int src_w = argc > 1 ? atoi (argv[1]) : DEFAULT_SRC_W;
+    int src_h = argc > 1 ? atoi (argv[2]) : DEFAULT_SRC_H;
+    int dst_w = argc > 1 ? atoi (argv[3]) : DEFAULT_DST_W;
+    int dst_h = argc > 1 ? atoi (argv[4]) : DEFAULT_DST_H;
+    int iterations = argc > 5 ? atoi (argv[5]) : DEFAULT_ITERATIONS;
+    if (src_w <= 0 or src_h <= 0 or dst_w <= 0 or dst_h <= 0
+        or iterations <= 0)
+    {
+        std::cerr << "Sizes and iterations must be positive" << std::endl;
+        return EXIT_FAILURE;
+    }
+    run (src_w, src_h, dst_w, dst_h, iterations, false);
+    run (src_w, src_h, dst_w, dst_h, iterations, true);
+    return EXIT_SUCCESS;
+}
@@ -1,16 +1,40 @@
+/*
+searchlistener.h - Interface to receive the search request results.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
 
 #ifndef SEARCHLISTENER_H
 #define SEARCHLISTENER_H
 
-#include "searchresult.h"
+#include <memory>
+
+#include "mediasresult.h"
 
 class SearchListener {
 
     public:
 
-        virtual void search_finished (SearchResult& r) = 0;
+        // Notify that the search has finished
+        virtual void search_finished (
+            std::unique_ptr<MediasResult>& result) = 0;
 
 };
 
 #endif
-
@@ -0,0 +1,49 @@
+/*
+searchrequest.cpp - Search medias by their title.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "searchrequest.h"
+
+SearchRequest::SearchRequest (const std::string& server_address,
+                              const std::string& category,
+                              const std::string& text,
+                              SearchListener& listener):
+    MediasRequest (server_address, category), text (text), listener (listener)
+{}
+
+SearchRequest::~SearchRequest ()
+{}
+
+std::string SearchRequest::get_api_function () const
+{
+    return "search?category=" + escape (get_category ()) + "&text="
+        + escape (text);
+}
+
+std::string SearchRequest::get_root () const
+{
+    return "search";
+}
+
+void SearchRequest::notify (std::unique_ptr<MediasResult>& result)
+{
+    listener.search_finished (result);
+}
@@ -0,0 +1,62 @@
+/*
+searchrequest.h - Search medias by their title.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SEARCHREQUEST_H
+#define SEARCHREQUEST_H
+
+#include <string>
+
+#include "mediasrequest.h"
+#include "searchlistener.h"
+
+class SearchRequest: public MediasRequest {
+
+    private:
+
+        // Text to search.
+        std::string text;
+
+        // Listener to receive the event of search finished.
+        SearchListener& listener;
+
+    public:
+
+        SearchRequest (const std::string& server_address,
+                       const std::string& category,
+                       const std::string& text,
+                       SearchListener& listener);
+        ~SearchRequest ();
+
+    protected:
+
+        // Return the API function to call.
+        std::string get_api_function () const;
+
+        // Return the name of the JSON member with the list of medias.
+        std::string get_root () const;
+
+        // Pass the result to the listener.
+        void notify (std::unique_ptr<MediasResult>& result);
+
+};
+
+#endif
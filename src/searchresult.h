@@ -1,10 +0,0 @@
-
-#ifndef SEARCHRESULT_H
-#define SEARCHRESULT_H
-
-class SearchResult {
-
-};
-
-#endif
-
@@ -32,7 +32,8 @@ const float SplashView::LOGO_RATIO = 0.66;
 const int SplashView::TIMEOUT = 0;
 
 SplashView::SplashView (ViewControllerInterface& controller):
-    View (controller), logo (), timeout_signal_connected (false)
+    View (controller), logo (), timeout_signal_connected (false),
+    draw_connection ()
 {
     // Add the logo to the main box
     auto& box = get_box ();
@@ -40,7 +41,7 @@ SplashView::SplashView (ViewControllerInterface& controller):
 
     // Load the logo into a pixbuf
     auto screen = Gdk::Screen::get_default ();
-    auto pixbuf = Gdk::Pixbuf::create_from_file (
+    auto pixbuf = get_controller ().get_icon_atlas ().get (
         Paths::get_logo (), screen->get_width () * LOGO_RATIO, -1);
 
     // Set the pixbuf of the logo image
@@ -55,14 +56,23 @@ SplashView::~SplashView ()
 
 void SplashView::show ()
 {
-    // Change of view after some seconds
-    if (not timeout_signal_connected) {
-        Glib::signal_timeout ().connect (
-            sigc::mem_fun (*this, &SplashView::on_timeout), TIMEOUT);
-        timeout_signal_connected = true;
+    /* Change of view some seconds after the logo is on the screen, so that
+       the next view is built after the first frame */
+    if (not timeout_signal_connected and not draw_connection.connected ()) {
+        draw_connection = logo.signal_draw ().connect (
+            sigc::mem_fun (*this, &SplashView::on_logo_drawn));
     }
 }
 
+bool SplashView::on_logo_drawn (const Cairo::RefPtr<Cairo::Context>&)
+{
+    draw_connection.disconnect ();
+    Glib::signal_timeout ().connect (
+        sigc::mem_fun (*this, &SplashView::on_timeout), TIMEOUT);
+    timeout_signal_connected = true;
+    return false;
+}
+
 bool SplashView::on_timeout ()
 {
     get_controller ().switch_view ("choose-profile");
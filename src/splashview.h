@@ -43,6 +43,9 @@ class SplashView: public View {
         // Stores whether the timeout signal has been connected or not
         bool timeout_signal_connected;
 
+        // Connection to wait for the logo to be drawn
+        sigc::connection draw_connection;
+
     public:
 
         SplashView (ViewControllerInterface& controller);
@@ -53,6 +56,9 @@ class SplashView: public View {
 
     private:
 
+        // The logo has been drawn for the first time
+        bool on_logo_drawn (const Cairo::RefPtr<Cairo::Context>& context);
+
         // Timeout to change view consumed
         bool on_timeout ();
 
@@ -0,0 +1,81 @@
+/*
+startuptrace.cpp - Timeline of the start of the application.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+#include "startuptrace.h"
+
+const gint64 StartupTrace::process_start = g_get_monotonic_time ();
+
+StartupTrace::StartupTrace (bool print):
+    print (print), events (), pending ()
+{}
+
+StartupTrace::~StartupTrace ()
+{
+    for (auto& p: pending) {
+        p.second.disconnect ();
+    }
+}
+
+void StartupTrace::mark (const std::string& event)
+{
+    if (get_time (event) >= 0) {
+        return;
+    }
+    auto time = g_get_monotonic_time () - process_start;
+    if (print) {
+        auto previous = events.empty () ? 0 : events.back ().second;
+        std::cerr << "startup: " << event << " at " << std::fixed
+            << std::setprecision (1) << time / 1000.0 << " ms (+"
+            << (time - previous) / 1000.0 << " ms)" << std::endl;
+    }
+    events.emplace_back (event, time);
+}
+
+void StartupTrace::mark_on_draw (Gtk::Widget& widget,
+                                 const std::string& event)
+{
+    if (get_time (event) >= 0 or pending.count (event)) {
+        return;
+    }
+    pending[event] = widget.signal_draw ().connect (
+        [this, event] (const Cairo::RefPtr<Cairo::Context>&) {
+            // The slot (and its copy of the name) goes away on disconnect
+            auto name = event;
+            pending[name].disconnect ();
+            pending.erase (name);
+            mark (name);
+            return false;
+        });
+}
+
+gint64 StartupTrace::get_time (const std::string& event) const
+{
+    auto it = std::find_if (events.begin (), events.end (),
+        [&event] (const std::pair<std::string, gint64>& e) {
+            return e.first == event;
+        });
+    return it != events.end () ? it->second : -1;
+}
@@ -0,0 +1,71 @@
+/*
+startuptrace.h - Timeline of the start of the application.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+#include <glib.h>
+#include <gtkmm/widget.h>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Record when the milestones of the start happen (first frame, profiles
+   shown), measured from the start of the process, to track the regressions
+   of the cold start. Each milestone is recorded once. It must be used from
+   the main thread. */
+class StartupTrace {
+
+    private:
+
+        // Time of the start of the process (the static initialization),
+        // in microseconds of the monotonic clock
+        static const gint64 process_start;
+
+        // True to print the milestones as they happen
+        bool print;
+
+        // Milestones reached, with their time since the process start
+        std::vector<std::pair<std::string, gint64> > events;
+
+        // Milestones waiting for a widget to be drawn
+        std::map<std::string, sigc::connection> pending;
+
+    public:
+
+        StartupTrace (bool print);
+        ~StartupTrace ();
+
+        // Record a milestone now.
+        void mark (const std::string& event);
+
+        // Record a milestone when a widget is drawn for the next time.
+        void mark_on_draw (Gtk::Widget& widget, const std::string& event);
+
+        /* Return the time of a milestone since the process start, in
+           microseconds, or -1 if it hasn't happened yet. */
+        gint64 get_time (const std::string& event) const;
+
+};
+
+#endif
@@ -0,0 +1,54 @@
+/*
+teesink.cpp - Send the body of a response to two sinks.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "teesink.h"
+
+TeeSink::TeeSink (BodySink& sink, BodySink* copy):
+    sink (sink), copy (copy), copy_error (false)
+{}
+
+TeeSink::~TeeSink ()
+{}
+
+void TeeSink::set_length (size_t length)
+{
+    sink.set_length (length);
+    if (copy) {
+        copy->set_length (length);
+    }
+}
+
+bool TeeSink::write (const char* bytes, size_t length)
+{
+    if (copy and not copy_error) {
+        copy_error = not copy->write (bytes, length);
+    }
+    return sink.write (bytes, length);
+}
+
+void TeeSink::close ()
+{
+    sink.close ();
+    if (copy) {
+        copy->close ();
+    }
+}
@@ -0,0 +1,63 @@
+/*
+teesink.h - Send the body of a response to two sinks.
+
+This file is part of tvfamily-gtk.
+
+Copyright 2019 Antonio Serrano Hernandez
+
+tvfamily-gtk is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+tvfamily-gtk is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with tvfamily-gtk; see the file COPYING.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEESINK_H
+#define TEESINK_H
+
+#include "bodysink.h"
+
+/* Pass the body to a main sink and keep a copy in a second one. A failure
+   of the copy doesn't abort the transfer, the copy is just dropped. */
+class TeeSink: public BodySink {
+
+    private:
+
+        // The sink that receives the body
+        BodySink& sink;
+
+        // The sink that receives the copy, or null
+        BodySink* copy;
+
+        // True if the copy failed
+        bool copy_error;
+
+    public:
+
+        TeeSink (BodySink& sink, BodySink* copy);
+        ~TeeSink ();
+
+        // Return true if the copy has received the whole body.
+        inline bool is_copy_complete () const
+            { return copy and not copy_error; }
+
+        // Implementation of the BodySink interface.
+        void set_length (size_t length);
+
+        // Implementation of the BodySink interface.
+        bool write (const char* bytes, size_t length);
+
+        // Implementation of the BodySink interface.
+        void close ();
+
+};
+
+#endif
@@ -22,26 +22,48 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 
 #include <gtkmm/cssprovider.h>
 #include <gtkmm/stylecontext.h>
+#include <stdexcept>
 
-#include "viewcontroller.h"
+#include "mediainfoview.h"
+#include "mediasview.h"
+#include "newprofileview.h"
 #include "paths.h"
+#include "pictureview.h"
+#include "playerview.h"
+#include "profilesview.h"
+#include "splashview.h"
+#include "viewcontroller.h"
 
 ViewController::ViewController (Glib::RefPtr<Gtk::Application>& app,
-                                const std::string& server_address):
-    app (app), window (), stack (),
-    splash_view (*this),
-    profiles_view (*this),
-    newprofile_view (*this),
-    medias_view (*this),
-    picture_view (*this),
-    mediainfo_view (*this),
-    player_view (*this),
-    views_map ({{"splash", &splash_view}, {"choose-profile", &profiles_view},
-        {"new-profile", &newprofile_view}, {"medias", &medias_view},
-        {"change-picture", &picture_view}, {"media-info", &mediainfo_view},
-        {"player", &player_view}}),
-    core (server_address)
+                                const std::string& server_address,
+                                unsigned int num_workers,
+                                bool http2,
+                                int prefetch_rows,
+                                long frame_budget,
+                                bool trace_startup):
+    app (app), window (), stack (), scheduler (window, frame_budget),
+    main_queue (scheduler), icon_atlas (Paths::get_icon_cache ()),
+    startup_trace (trace_startup), views_map (),
+    core (server_address, num_workers, http2)
 {
+    /* Register the views. Each one is built the first time it's shown, so
+       that only the splash view is built before the first frame. */
+    views_map["splash"].create =
+        [this] { return std::make_unique<SplashView> (*this); };
+    views_map["choose-profile"].create =
+        [this] { return std::make_unique<ProfilesView> (*this); };
+    views_map["new-profile"].create =
+        [this] { return std::make_unique<NewProfileView> (*this); };
+    views_map["medias"].create = [this, prefetch_rows] {
+        return std::make_unique<MediasView> (*this, prefetch_rows);
+    };
+    views_map["change-picture"].create =
+        [this] { return std::make_unique<PictureView> (*this); };
+    views_map["media-info"].create =
+        [this] { return std::make_unique<MediaInfoView> (*this); };
+    views_map["player"].create =
+        [this] { return std::make_unique<PlayerView> (*this); };
+
     window.set_default_size (1280, 720);
 
     // Set styles
@@ -62,11 +84,7 @@ ViewController::ViewController (Glib::RefPtr<Gtk::Application>& app,
     // Add the stack to the window
     window.add (stack);
     window.show_all ();
-
-    // Populate the stack
-    for (auto x: views_map) {
-        stack.add (x.second->get_box (), x.first);
-    }
+    startup_trace.mark_on_draw (window, "first frame");
 
     // Show the first view
     switch_view ("splash");
@@ -81,8 +99,9 @@ void ViewController::switch_view (const std::string& new_view)
     last_view = stack.get_visible_child_name ();
 
     // Show the new child
+    auto& view = get_view (new_view);
     stack.set_visible_child (new_view);
-    views_map[new_view]->show ();
+    view.show ();
 }
 
 void ViewController::switch_view (const std::string& new_view,
@@ -92,8 +111,9 @@ void ViewController::switch_view (const std::string& new_view,
     last_view = stack.get_visible_child_name ();
 
     // Show the new child
+    auto& view = get_view (new_view);
     stack.set_visible_child (new_view);
-    views_map[new_view]->show (data);
+    view.show (data);
 }
 
 void ViewController::back ()
@@ -111,6 +131,22 @@ void ViewController::exit ()
     app->quit ();
 }
 
+View& ViewController::get_view (const std::string& name)
+{
+    auto it = views_map.find (name);
+    if (it == views_map.end ()) {
+        throw std::runtime_error ("unknown view " + name);
+    }
+    auto& entry = it->second;
+    if (not entry.view) {
+        entry.view = entry.create ();
+        stack.add (entry.view->get_box (), name);
+        // The stack doesn't switch to hidden children
+        entry.view->get_box ().show ();
+    }
+    return *entry.view;
+}
+
 bool ViewController::on_key_press (GdkEventKey* event)
 {
     if (event->keyval == FULLSCREEN_KEY) {
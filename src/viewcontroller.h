@@ -26,17 +26,15 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #include <gtkmm/application.h>
 #include <gtkmm/stack.h>
 #include <gtkmm/window.h>
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
 
 #include "core.h"
-#include "mediainfoview.h"
-#include "mediasview.h"
-#include "newprofileview.h"
-#include "pictureview.h"
-#include "playerview.h"
-#include "profilesview.h"
-#include "splashview.h"
+#include "framescheduler.h"
+#include "startuptrace.h"
+#include "view.h"
 #include "viewcontrollerinterface.h"
 
 class ViewController: public ViewControllerInterface {
@@ -55,23 +53,36 @@ class ViewController: public ViewControllerInterface {
         // Container for all the views
         Gtk::Stack stack;
 
-        // Dictionary with the views indexed by name
-        std::map<std::string, View*> views_map;
-
         // ID of the last view
         std::string last_view;
 
         // Flag that stores if the window is in fullscreen mode
         bool is_fullscreen;
 
-        // References to the views
-        SplashView     splash_view;
-        ProfilesView   profiles_view;
-        NewProfileView newprofile_view;
-        MediasView     medias_view;
-        PictureView    picture_view;
-        MediaInfoView  mediainfo_view;
-        PlayerView     player_view;
+        // Scheduler of the changes of the interface on the window frames
+        FrameScheduler scheduler;
+
+        // Queue of jobs for the main loop, shared by all the views
+        MainQueue main_queue;
+
+        // Icons of the views, rendered once
+        IconAtlas icon_atlas;
+
+        // Milestones of the start of the application
+        StartupTrace startup_trace;
+
+        // A view, built the first time it's shown
+        struct ViewEntry {
+
+            // Function to build the view
+            std::function<std::unique_ptr<View> ()> create;
+
+            // The view, null until it's built
+            std::unique_ptr<View> view;
+        };
+
+        // Dictionary with the views indexed by name
+        std::map<std::string, ViewEntry> views_map;
 
         // The application's core
         Core core;
@@ -79,7 +90,12 @@ class ViewController: public ViewControllerInterface {
     public:
 
         ViewController (Glib::RefPtr<Gtk::Application>& app,
-                        const std::string& server_address);
+                        const std::string& server_address,
+                        unsigned int num_workers,
+                        bool http2,
+                        int prefetch_rows,
+                        long frame_budget,
+                        bool trace_startup);
         ~ViewController ();
 
         // Implementation of ViewControllerInterface interface
@@ -88,6 +104,19 @@ class ViewController: public ViewControllerInterface {
         // Implementation of ViewControllerInterface interface
         inline Core& get_core () { return core; }
 
+        // Implementation of ViewControllerInterface interface
+        inline MainQueue& get_main_queue () { return main_queue; }
+
+        // Implementation of ViewControllerInterface interface
+        inline IconAtlas& get_icon_atlas () { return icon_atlas; }
+
+        // Implementation of ViewControllerInterface interface
+        inline StartupTrace& get_startup_trace () { return startup_trace; }
+
+        // Return the scheduler (to query its counters).
+        inline const FrameScheduler& get_scheduler () const
+            { return scheduler; }
+
         // Implementation of ViewControllerInterface interface
         void switch_view (const std::string& new_view);
 
@@ -106,6 +135,9 @@ class ViewController: public ViewControllerInterface {
 
     private:
 
+        // Return a view, building it and adding it to the stack if needed
+        View& get_view (const std::string& name);
+
         // Callback executed when a key is pressed (to manage fullscreen)
         bool on_key_press (GdkEventKey* event);
 
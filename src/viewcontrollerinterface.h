@@ -27,6 +27,9 @@ along with tvfamily-gtk; see the file COPYING.  If not, see
 #include <string>
 
 #include "core.h"
+#include "iconatlas.h"
+#include "mainqueue.h"
+#include "startuptrace.h"
 #include "viewswitchdata.h"
 
 class ViewControllerInterface {
@@ -36,6 +39,15 @@ class ViewControllerInterface {
         /* Return the application's core. */
         virtual Core& get_core () = 0;
 
+        /* Return the queue to pass results to the main loop. */
+        virtual MainQueue& get_main_queue () = 0;
+
+        /* Return the icons rendered for the widgets. */
+        virtual IconAtlas& get_icon_atlas () = 0;
+
+        /* Return the milestones of the start of the application. */
+        virtual StartupTrace& get_startup_trace () = 0;
+
         /* Return the main window. */
         virtual Gtk::Window& get_window () = 0;
 
@@ -11,6 +11,8 @@ T=$SRC/tvfamily-gtk
 DATA="$ROOT/data"
 TVFAMILY_LOGO="$DATA/tvfamily.svg"
 SERVER="localhost:8888"
+BENCH_PORT=18443
+BENCH_BACKEND_PORT=18081
 SERVER_SCRIPT="$ROOT/../tvfamily/run.sh"
 SERVER_DATA_DIR="$HOME/.tvfamily"
 PROFILES_DIR="$SERVER_DATA_DIR/profiles"
@@ -150,6 +152,32 @@ function test_profile_management {
     rm $TEST/test.png
 }
 
+# Benchmark of the load of a poster grid (5 columns x 6 rows) by the
+# RequestManager of the client, with HTTP/1.1 and HTTP/2. The transfers are
+# only multiplexed with TLS, so nghttpx serves a picture over https, with
+# both protocols, from nghttpd with a self-signed certificate.
+function bench_http2 {
+    local dir=$(mktemp -d)
+    local url="https://localhost:$BENCH_PORT"
+    mkdir -p $dir/files/api
+    cp $TVFAMILY_LOGO $dir/files/api/poster
+    openssl req -x509 -newkey rsa:2048 -nodes -days 1 -subj /CN=localhost \
+        -addext subjectAltName=DNS:localhost -keyout $dir/key.pem \
+        -out $dir/cert.pem 2> /dev/null
+    nghttpd --no-tls -d $dir/files $BENCH_BACKEND_PORT &
+    local backend=$!
+    nghttpx --frontend="127.0.0.1,$BENCH_PORT" \
+        --backend="127.0.0.1,$BENCH_BACKEND_PORT;;proto=h2" --workers=1 \
+        --errorlog-file=/dev/null $dir/key.pem $dir/cert.pem &
+    local proxy=$!
+    sleep 1
+    make -C $SRC requestbench > /dev/null
+    $SRC/requestbench -c $dir/cert.pem $url poster
+    $SRC/requestbench -2 -c $dir/cert.pem $url poster
+    kill $proxy $backend
+    rm -r $dir
+}
+
 # Test last profile supression
 function test_delete_last_profile {
     start_client
@@ -170,6 +198,9 @@ clean_cov
 test_args
 test_no_connection1
 test_profile_management
+if [ -n "$BENCH" ]; then
+    bench_http2
+fi
 test_delete_last_profile
 
 # Generate coverage files